@@ -4,12 +4,19 @@
 
 #pragma once
 
+#include "ArduinoJson/BlockCache.hpp"
+#include "ArduinoJson/Deserialization/JsonSizer.hpp"
 #include "ArduinoJson/DynamicJsonBuffer.hpp"
+#include "ArduinoJson/DynamicJsonBufferPool.hpp"
+#include "ArduinoJson/HybridJsonBuffer.hpp"
 #include "ArduinoJson/JsonArray.hpp"
+#include "ArduinoJson/JsonKeyTable.hpp"
 #include "ArduinoJson/JsonObject.hpp"
+#include "ArduinoJson/MemoryResourceAllocator.hpp"
 #include "ArduinoJson/StaticJsonBuffer.hpp"
 
 #include "ArduinoJson/Deserialization/JsonParserImpl.hpp"
+#include "ArduinoJson/Deserialization/JsonSizerImpl.hpp"
 #include "ArduinoJson/JsonArrayImpl.hpp"
 #include "ArduinoJson/JsonBufferImpl.hpp"
 #include "ArduinoJson/JsonObjectImpl.hpp"
@@ -0,0 +1,137 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#pragma once
+
+#include "Data/Lock.hpp"
+#include "Data/NonCopyable.hpp"
+#include "DynamicJsonBuffer.hpp"
+
+namespace ArduinoJson {
+namespace Internals {
+
+// A cache of memory blocks between DynamicJsonBuffers and their allocator.
+//
+// The blocks freed by a DynamicJsonBuffer stay in the cache, sorted by size
+// class, so that the next buffer reuses them instead of calling the upstream
+// allocator. The size classes follow the doubling sequence of
+// DynamicJsonBuffer (64, 128, 256... plus the header of a block); bigger
+// blocks bypass the cache.
+//
+// To share the cache between threads, use a real mutex (like std::mutex) for
+// TMutex.
+template <typename TUpstream = DefaultAllocator, typename TMutex = NoMutex>
+class BlockCache : NonCopyable {
+  struct Header {
+    Header *next;
+    size_t sizeClass;
+  };
+
+ public:
+  enum { SizeClassCount = 16 };
+
+  // The allocator to give to DynamicJsonBufferBase
+  class Allocator {
+   public:
+    explicit Allocator(BlockCache *cache) : _cache(cache) {}
+
+    void *allocate(size_t size) {
+      return _cache->allocate(size);
+    }
+    void deallocate(void *pointer) {
+      _cache->deallocate(pointer);
+    }
+
+   private:
+    BlockCache *_cache;
+  };
+
+  // Creates a cache that keeps up to `maxBlocksPerClass` free blocks in each
+  // size class.
+  explicit BlockCache(size_t maxBlocksPerClass = 8,
+                      TUpstream upstream = TUpstream())
+      : _upstream(upstream), _maxBlocksPerClass(maxBlocksPerClass) {
+    for (size_t i = 0; i < SizeClassCount; i++) {
+      _free[i] = NULL;
+      _freeCount[i] = 0;
+    }
+  }
+
+  ~BlockCache() {
+    for (size_t i = 0; i < SizeClassCount; i++) {
+      while (_free[i]) {
+        Header *header = _free[i];
+        _free[i] = header->next;
+        _upstream.deallocate(header);
+      }
+    }
+  }
+
+  Allocator allocator() {
+    return Allocator(this);
+  }
+
+  // Gets the number of free blocks in the cache
+  size_t size() const {
+    size_t total = 0;
+    for (size_t i = 0; i < SizeClassCount; i++) total += _freeCount[i];
+    return total;
+  }
+
+  void *allocate(size_t size) {
+    size_t sizeClass = sizeClassOf(size);
+    if (sizeClass < SizeClassCount) {
+      Lock<TMutex> lock(_mutex);
+      Header *header = _free[sizeClass];
+      if (header) {
+        _free[sizeClass] = header->next;
+        _freeCount[sizeClass]--;
+        return header + 1;
+      }
+    }
+    if (sizeClass < SizeClassCount) size = sizeOfClass(sizeClass);
+    Header *header =
+        static_cast<Header *>(_upstream.allocate(sizeof(Header) + size));
+    if (!header) return NULL;
+    header->sizeClass = sizeClass;
+    return header + 1;
+  }
+
+  void deallocate(void *pointer) {
+    if (!pointer) return;
+    Header *header = static_cast<Header *>(pointer) - 1;
+    size_t sizeClass = header->sizeClass;
+    if (sizeClass < SizeClassCount) {
+      Lock<TMutex> lock(_mutex);
+      if (_freeCount[sizeClass] < _maxBlocksPerClass) {
+        header->next = _free[sizeClass];
+        _free[sizeClass] = header;
+        _freeCount[sizeClass]++;
+        return;
+      }
+    }
+    _upstream.deallocate(header);
+  }
+
+ private:
+  static size_t sizeOfClass(size_t sizeClass) {
+    // leave room for the header of DynamicJsonBuffer's blocks
+    return (size_t(64) << sizeClass) + 4 * sizeof(void *);
+  }
+
+  static size_t sizeClassOf(size_t size) {
+    size_t sizeClass = 0;
+    while (sizeClass < SizeClassCount && size > sizeOfClass(sizeClass))
+      sizeClass++;
+    return sizeClass;
+  }
+
+  TUpstream _upstream;
+  TMutex _mutex;
+  size_t _maxBlocksPerClass;
+  Header *_free[SizeClassCount];
+  size_t _freeCount[SizeClassCount];
+};
+}
+}
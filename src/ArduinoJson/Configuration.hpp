@@ -44,6 +44,44 @@
 #define ARDUINOJSON_DEFAULT_NESTING_LIMIT 10
 #endif
 
+// Don't spend memory on an index for JsonArray and JsonObject
+#ifndef ARDUINOJSON_ARRAY_INDEX_THRESHOLD
+#define ARDUINOJSON_ARRAY_INDEX_THRESHOLD 0
+#endif
+#ifndef ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+#define ARDUINOJSON_OBJECT_INDEX_THRESHOLD 0
+#endif
+
+// Don't store the hash of the keys in JsonPair
+#ifndef ARDUINOJSON_ENABLE_KEY_HASH
+#define ARDUINOJSON_ENABLE_KEY_HASH 0
+#endif
+
+// Don't support JsonKeyTable
+#ifndef ARDUINOJSON_ENABLE_KEY_TABLE
+#define ARDUINOJSON_ENABLE_KEY_TABLE 0
+#endif
+
+// Copy every key of the objects in arrays
+#ifndef ARDUINOJSON_REUSE_SIBLING_KEYS
+#define ARDUINOJSON_REUSE_SIBLING_KEYS 0
+#endif
+
+// Use the small but approximate float parser
+#ifndef ARDUINOJSON_ENABLE_EXACT_FLOAT_PARSING
+#define ARDUINOJSON_ENABLE_EXACT_FLOAT_PARSING 0
+#endif
+
+// Convert the integers one digit at a time
+#ifndef ARDUINOJSON_ENABLE_FAST_INTEGER_PARSING
+#define ARDUINOJSON_ENABLE_FAST_INTEGER_PARSING 0
+#endif
+
+// Don't use the vector instructions
+#ifndef ARDUINOJSON_ENABLE_SIMD
+#define ARDUINOJSON_ENABLE_SIMD 0
+#endif
+
 #else  // ARDUINOJSON_EMBEDDED_MODE
 
 // On a computer we have plenty of memory so we can use doubles
@@ -84,6 +122,53 @@
 #define ARDUINOJSON_DEFAULT_NESTING_LIMIT 50
 #endif
 
+// Index the elements of a JsonArray to access them in constant time, when a
+// non-const function accesses the specified index or a further one
+// (0 = never)
+#ifndef ARDUINOJSON_ARRAY_INDEX_THRESHOLD
+#define ARDUINOJSON_ARRAY_INDEX_THRESHOLD 16
+#endif
+
+// Index the keys of a JsonObject in a hash table, when a non-const function
+// searches a key in an object with the specified number of keys (0 = never)
+#ifndef ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+#define ARDUINOJSON_OBJECT_INDEX_THRESHOLD 16
+#endif
+
+// Store the hash of the key in each JsonPair, so that JsonObject can skip most
+// string comparisons when it searches a key
+#ifndef ARDUINOJSON_ENABLE_KEY_HASH
+#define ARDUINOJSON_ENABLE_KEY_HASH 1
+#endif
+
+// Allow JsonBuffers to take the keys from a JsonKeyTable
+#ifndef ARDUINOJSON_ENABLE_KEY_TABLE
+#define ARDUINOJSON_ENABLE_KEY_TABLE 1
+#endif
+
+// Make the parser reuse the keys of the previous object of an array, when the
+// next object has the same key at the same position
+#ifndef ARDUINOJSON_REUSE_SIBLING_KEYS
+#define ARDUINOJSON_REUSE_SIBLING_KEYS 1
+#endif
+
+// Parse the doubles with correct rounding, using the Eisel-Lemire algorithm
+// and a 10KB table of the powers of five
+#ifndef ARDUINOJSON_ENABLE_EXACT_FLOAT_PARSING
+#define ARDUINOJSON_ENABLE_EXACT_FLOAT_PARSING 1
+#endif
+
+// Convert the integers eight digits at a time, on little-endian CPUs
+#ifndef ARDUINOJSON_ENABLE_FAST_INTEGER_PARSING
+#define ARDUINOJSON_ENABLE_FAST_INTEGER_PARSING 1
+#endif
+
+// Skip the spaces and scan the strings with SSE2 or AVX2, when the compiler
+// targets them and the input is contiguous
+#ifndef ARDUINOJSON_ENABLE_SIMD
+#define ARDUINOJSON_ENABLE_SIMD 1
+#endif
+
 #endif  // ARDUINOJSON_EMBEDDED_MODE
 
 #ifdef ARDUINO
@@ -130,11 +215,61 @@
 #endif
 #endif
 
+// Catch the exceptions of the memory resources, see MemoryResourceAllocator
+#ifndef ARDUINOJSON_ENABLE_EXCEPTIONS
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND)
+#define ARDUINOJSON_ENABLE_EXCEPTIONS 1
+#else
+#define ARDUINOJSON_ENABLE_EXCEPTIONS 0
+#endif
+#endif
+
 // Enable deprecated functions by default
 #ifndef ARDUINOJSON_ENABLE_DEPRECATED
 #define ARDUINOJSON_ENABLE_DEPRECATED 1
 #endif
 
+// Make the parser remove the duplicate keys of each object, so that the last
+// value wins like with JsonObject::set(); otherwise the first one wins.
+// The large objects get their hash table when they are parsed, see
+// JsonObject::removeDuplicateKeys().
+#ifndef ARDUINOJSON_REMOVE_DUPLICATE_KEYS
+#define ARDUINOJSON_REMOVE_DUPLICATE_KEYS 1
+#endif
+
+// Make the parser store the arrays of numbers contiguously, see
+// JsonArray::isPacked(). The numbers are converted when parsed, so they are
+// not serialized exactly as they were written in the input.
+#ifndef ARDUINOJSON_ENABLE_PACKED_ARRAYS
+#define ARDUINOJSON_ENABLE_PACKED_ARRAYS 0
+#endif
+
+// Make the parser store the short strings in the JsonVariant instead of the
+// JsonBuffer. CAUTION: as<const char*>() then returns a pointer in the
+// JsonVariant, so it must not be called on a temporary copy.
+#ifndef ARDUINOJSON_ENABLE_INLINE_STRINGS
+#define ARDUINOJSON_ENABLE_INLINE_STRINGS 0
+#endif
+
+// Store the links between the nodes in 48 bits, and the type of the
+// JsonVariant in one byte, to reduce the size of the array nodes on 64-bit
+// hosts, see ListNode.
+#ifndef ARDUINOJSON_COMPACT_NODES
+#define ARDUINOJSON_COMPACT_NODES 0
+#endif
+
+// Make the parser convert true, false, null and the numbers when it reads
+// them, instead of storing their text. as<char*>() then returns NULL for these
+// values, and the numbers are not serialized exactly as they were written.
+#ifndef ARDUINOJSON_DECODE_LITERALS
+#define ARDUINOJSON_DECODE_LITERALS 0
+#endif
+
+// Record the memory usage of JsonBuffers, see JsonBufferStats
+#ifndef ARDUINOJSON_ENABLE_STATS
+#define ARDUINOJSON_ENABLE_STATS 0
+#endif
+
 // Control the exponentiation threshold for big numbers
 // CAUTION: cannot be more that 1e9 !!!!
 #ifndef ARDUINOJSON_POSITIVE_EXPONENTIATION_THRESHOLD
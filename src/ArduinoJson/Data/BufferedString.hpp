@@ -0,0 +1,78 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#pragma once
+
+#include <stddef.h>  // for size_t
+#include <string.h>  // for memcpy
+
+namespace ArduinoJson {
+namespace Internals {
+
+// A string of the parser that keeps its first characters in a local buffer.
+// Nothing is written in the JsonBuffer until the string is longer than
+// MaxLength or c_str() is called, so that a short string may be stored
+// somewhere else (see InlineString and InterningString).
+template <typename TString, size_t N>
+class BufferedString {
+ public:
+  enum { MaxLength = N };
+
+  explicit BufferedString(TString str) : _str(str), _length(0) {}
+
+  void append(char c) {
+    if (_length < MaxLength) {
+      _chars[_length++] = c;
+      return;
+    }
+    if (_length == MaxLength) {
+      _str.append(_chars, MaxLength);
+      _length++;
+    }
+    _str.append(c);
+  }
+
+  void append(const char *chars, size_t length) {
+    if (_length + length <= MaxLength) {
+      memcpy(_chars + _length, chars, length);
+      _length += length;
+      return;
+    }
+    if (_length <= MaxLength) {
+      _str.append(_chars, _length);
+      _length = MaxLength + 1;
+    }
+    _str.append(chars, length);
+  }
+
+  // Tells whether the whole string is in the local buffer
+  bool isBuffered() const {
+    return _length <= MaxLength;
+  }
+
+  // Gets the local buffer (not null-terminated)
+  const char *chars() const {
+    return _chars;
+  }
+
+  size_t size() const {
+    return _length;
+  }
+
+  // Gets the string in the JsonBuffer, or NULL if the JsonBuffer is full
+  const char *c_str() {
+    if (isBuffered()) {
+      _str.append(_chars, _length);
+      _length = MaxLength + 1;
+    }
+    return _str.c_str();
+  }
+
+ private:
+  TString _str;
+  size_t _length;  // MaxLength + 1 once the string went to the JsonBuffer
+  char _chars[MaxLength];
+};
+}
+}
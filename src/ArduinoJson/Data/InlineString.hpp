@@ -0,0 +1,27 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#pragma once
+
+#include "BufferedString.hpp"
+#include "JsonVariantContent.hpp"
+
+namespace ArduinoJson {
+namespace Internals {
+
+// A string of the parser that is stored in the JsonVariant if it's short
+// enough (see ARDUINOJSON_ENABLE_INLINE_STRINGS).
+template <typename TString>
+class InlineString : public BufferedString<TString, InlineStringSize - 1> {
+ public:
+  explicit InlineString(TString str)
+      : BufferedString<TString, InlineStringSize - 1>(str) {}
+
+  // Tells whether the string fits in a JsonVariant
+  bool fits() const {
+    return this->isBuffered();
+  }
+};
+}
+}
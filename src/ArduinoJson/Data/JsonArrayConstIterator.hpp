@@ -0,0 +1,93 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#pragma once
+
+#include "ListConstIterator.hpp"
+#include "ListIterator.hpp"
+#include "PackedNumbers.hpp"
+
+namespace ArduinoJson {
+namespace Internals {
+
+// A read-only forward iterator for JsonArray.
+// It reads either the nodes of the list or the packed values, so that a
+// packed array is never converted by a const function.
+// The packed values are returned through a JsonVariant held by the iterator,
+// so the reference is only valid until the iterator moves.
+class JsonArrayConstIterator {
+  typedef ListConstIterator<JsonVariant> list_iterator;
+
+ public:
+  explicit JsonArrayConstIterator(const ListNode<JsonVariant> *node = NULL)
+      : _node(node), _packed(NULL), _chunk(NULL), _offset(0) {}
+
+  JsonArrayConstIterator(list_iterator it)
+      : _node(it), _packed(NULL), _chunk(NULL), _offset(0) {}
+
+  JsonArrayConstIterator(const ListIterator<JsonVariant> &it)
+      : _node(it), _packed(NULL), _chunk(NULL), _offset(0) {}
+
+  explicit JsonArrayConstIterator(const PackedNumbers &packed)
+      : _packed(&packed), _chunk(packed.firstChunk()), _offset(0) {
+    load();
+  }
+
+  const JsonVariant &operator*() const {
+    return _chunk ? _value : *_node;
+  }
+  const JsonVariant *operator->() {
+    return &**this;
+  }
+
+  bool operator==(const JsonArrayConstIterator &other) const {
+    return _node == other._node && _chunk == other._chunk &&
+           _offset == other._offset;
+  }
+
+  bool operator!=(const JsonArrayConstIterator &other) const {
+    return !(*this == other);
+  }
+
+  JsonArrayConstIterator &operator++() {
+    if (!_chunk) {
+      ++_node;
+      return *this;
+    }
+    if (++_offset == _chunk->count) {
+      _chunk = _chunk->next;
+      _offset = 0;
+    }
+    load();
+    return *this;
+  }
+
+  JsonArrayConstIterator &operator+=(size_t distance) {
+    if (!_chunk) {
+      _node += distance;
+      return *this;
+    }
+    while (_chunk && _offset + distance >= _chunk->count) {
+      distance -= _chunk->count - _offset;
+      _chunk = _chunk->next;
+      _offset = 0;
+    }
+    if (_chunk) _offset += distance;
+    load();
+    return *this;
+  }
+
+ private:
+  void load() {
+    if (_chunk) _value = _packed->toVariant(_chunk->values[_offset]);
+  }
+
+  list_iterator _node;
+  const PackedNumbers *_packed;
+  const PackedNumbers::Chunk *_chunk;
+  size_t _offset;
+  JsonVariant _value;
+};
+}
+}
@@ -0,0 +1,125 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#pragma once
+
+#include <stddef.h>  // for size_t
+
+#include "../Configuration.hpp"
+
+namespace ArduinoJson {
+
+// Memory usage of a JsonBuffer, returned by stats().
+// Only available when ARDUINOJSON_ENABLE_STATS is 1.
+//
+// The first two counters describe the current content, so that
+// size() == requested + padding.
+struct JsonBufferStats {
+  // bytes requested by alloc() and by the strings
+  size_t requested;
+  // bytes inserted to keep allocations aligned
+  size_t padding;
+  // free bytes left at the end of the blocks that are not used anymore,
+  // because an allocation or a string didn't fit
+  size_t abandoned;
+  // number of memory blocks currently owned by the buffer
+  size_t blocks;
+  // capacity of the largest block ever owned by the buffer
+  size_t largestBlock;
+  // largest size() ever reached, including before clear()
+  size_t highWaterMark;
+};
+
+namespace Internals {
+
+#if ARDUINOJSON_ENABLE_STATS
+
+// Keeps the counters of JsonBufferStats up to date.
+class JsonBufferStatsRecorder {
+ public:
+  JsonBufferStatsRecorder() {
+    _stats.requested = 0;
+    _stats.padding = 0;
+    _stats.abandoned = 0;
+    _stats.blocks = 0;
+    _stats.largestBlock = 0;
+    _stats.highWaterMark = 0;
+  }
+
+ protected:
+  void recordRequest(size_t bytes) {
+    _stats.requested += bytes;
+  }
+
+  void recordPadding(size_t bytes) {
+    _stats.padding += bytes;
+  }
+
+  void recordNewBlock(size_t capacity) {
+    _stats.blocks++;
+    if (capacity > _stats.largestBlock) _stats.largestBlock = capacity;
+  }
+
+  void recordFreeBlock() {
+    _stats.blocks--;
+  }
+
+  void recordClear(size_t size) {
+    if (size > _stats.highWaterMark) _stats.highWaterMark = size;
+    _stats.requested = 0;
+    _stats.padding = 0;
+  }
+
+  // The content counters saved by mark() and restored by release()
+  struct Checkpoint {
+    size_t requested;
+    size_t padding;
+  };
+
+  Checkpoint checkpoint() const {
+    Checkpoint checkpoint;
+    checkpoint.requested = _stats.requested;
+    checkpoint.padding = _stats.padding;
+    return checkpoint;
+  }
+
+  void recordRelease(size_t size, const Checkpoint& checkpoint) {
+    if (size > _stats.highWaterMark) _stats.highWaterMark = size;
+    _stats.requested = checkpoint.requested;
+    _stats.padding = checkpoint.padding;
+  }
+
+  JsonBufferStats getStats(size_t size, size_t abandoned) const {
+    JsonBufferStats stats = _stats;
+    stats.abandoned = abandoned;
+    if (size > stats.highWaterMark) stats.highWaterMark = size;
+    return stats;
+  }
+
+ private:
+  JsonBufferStats _stats;
+};
+
+#else
+
+// Does nothing when ARDUINOJSON_ENABLE_STATS is 0.
+// It's an empty base class, so it takes no space.
+class JsonBufferStatsRecorder {
+ protected:
+  void recordRequest(size_t) {}
+  void recordPadding(size_t) {}
+  void recordNewBlock(size_t) {}
+  void recordFreeBlock() {}
+  void recordClear(size_t) {}
+
+  struct Checkpoint {};
+  Checkpoint checkpoint() const {
+    return Checkpoint();
+  }
+  void recordRelease(size_t, const Checkpoint&) {}
+};
+
+#endif
+}
+}
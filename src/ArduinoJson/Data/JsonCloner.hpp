@@ -0,0 +1,143 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#pragma once
+
+#include "../JsonArray.hpp"
+#include "../JsonBuffer.hpp"
+#include "../JsonObject.hpp"
+#include "../JsonVariant.hpp"
+#include "../StringTraits/StringTraits.hpp"
+
+namespace ArduinoJson {
+namespace Internals {
+
+// Makes a deep copy of a JsonVariant in a JsonBuffer.
+// The values are allocated in depth-first order: each node is followed by its
+// key and by its value, so that a traversal reads the memory sequentially.
+// This internal class is not indended to be used directly.
+// Instead, use JsonBuffer::clone()
+class JsonCloner {
+ public:
+  // Returns false if the JsonBuffer is too small
+  static bool clone(JsonVariant &dst, const JsonVariant &src,
+                    JsonBuffer *buffer) {
+    switch (src._type) {
+      case JSON_ARRAY:
+        return cloneArray(dst, *src._content.asArray, buffer);
+
+      case JSON_OBJECT:
+        return cloneObject(dst, *src._content.asObject, buffer);
+
+      case JSON_STRING:
+      case JSON_UNPARSED:
+        dst._type = src._type;
+        return cloneString(dst._content.asString, src._content.asString,
+                           buffer);
+
+      default:
+        dst = src;
+        return true;
+    }
+  }
+
+  // Computes the number of bytes that clone() allocates in an empty
+  // JsonBuffer; the padding for alignment is included.
+  static size_t measure(const JsonVariant &src) {
+    size_t size = 0;
+    measure(size, src);
+    return size;
+  }
+
+ private:
+  static bool cloneArray(JsonVariant &dst, const JsonArray &src,
+                         JsonBuffer *buffer) {
+    JsonArray &array = buffer->createArray();
+    if (!array.success()) return false;
+    dst = array;
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+    if (src.isPacked()) return array._packed.copy(buffer, src._packed);
+#endif
+    for (JsonArray::const_iterator it = src.begin(); it != src.end(); ++it) {
+      JsonArray::iterator node = array.List<JsonVariant>::add();
+      if (node == array.end()) return false;
+      if (!clone(*node, *it, buffer)) return false;
+    }
+    return true;
+  }
+
+  static bool cloneObject(JsonVariant &dst, const JsonObject &src,
+                          JsonBuffer *buffer) {
+    JsonObject &object = buffer->createObject();
+    if (!object.success()) return false;
+    dst = object;
+    for (JsonObject::const_iterator it = src.begin(); it != src.end(); ++it) {
+      JsonObject::iterator node = object.List<JsonPair>::add();
+      if (node == object.end()) return false;
+      if (!cloneString(node->key, it->key, buffer)) return false;
+#if ARDUINOJSON_ENABLE_KEY_HASH
+      node->keyHash = hashString(node->key);
+#endif
+      if (!clone(node->value, it->value, buffer)) return false;
+    }
+    return true;
+  }
+
+  static bool cloneString(const char *&dst, const char *src,
+                          JsonBuffer *buffer) {
+    dst = StringTraits<const char *>::duplicate(src, buffer);
+    return dst != NULL || src == NULL;
+  }
+
+  static void measure(size_t &size, const JsonVariant &src) {
+    switch (src._type) {
+      case JSON_ARRAY: {
+        const JsonArray &array = *src._content.asArray;
+        alloc(size, sizeof(JsonArray));
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+        if (array.isPacked()) {
+          alloc(size, PackedNumbers::chunkSize(array.size()));
+          break;
+        }
+#endif
+        for (JsonArray::const_iterator it = array.begin(); it != array.end();
+             ++it) {
+          alloc(size, sizeof(JsonArray::node_type));
+          measure(size, *it);
+        }
+        break;
+      }
+
+      case JSON_OBJECT: {
+        const JsonObject &object = *src._content.asObject;
+        alloc(size, sizeof(JsonObject));
+        for (JsonObject::const_iterator it = object.begin();
+             it != object.end(); ++it) {
+          alloc(size, sizeof(JsonObject::node_type));
+          measureString(size, it->key);
+          measure(size, it->value);
+        }
+        break;
+      }
+
+      case JSON_STRING:
+      case JSON_UNPARSED:
+        measureString(size, src._content.asString);
+        break;
+
+      default:
+        break;
+    }
+  }
+
+  static void measureString(size_t &size, const char *str) {
+    if (str) alloc(size, strlen(str) + 1);
+  }
+
+  static void alloc(size_t &size, size_t bytes) {
+    size = round_size_up(size) + bytes;
+  }
+};
+}
+}
@@ -14,6 +14,12 @@ class JsonArray;
 class JsonObject;
 
 namespace Internals {
+// The size of the strings that fit in a JsonVariantContent, terminator included
+enum {
+  InlineStringSize =
+      sizeof(JsonUInt) > sizeof(JsonFloat) ? sizeof(JsonUInt) : sizeof(JsonFloat)
+};
+
 // A union that defines the actual content of a JsonVariant.
 // The enum JsonVariantType determines which member is in use.
 union JsonVariantContent {
@@ -22,6 +28,9 @@ union JsonVariantContent {
   const char* asString;  // asString can be null
   JsonArray* asArray;    // asArray cannot be null
   JsonObject* asObject;  // asObject cannot be null
+#if ARDUINOJSON_ENABLE_INLINE_STRINGS
+  char asInlineString[InlineStringSize];  // a short null-terminated string
+#endif
 };
 }
 }
@@ -21,7 +21,8 @@ enum JsonVariantType {
   JSON_NEGATIVE_INTEGER,  // JsonVariant stores an JsonUInt that must be negated
   JSON_ARRAY,             // JsonVariant stores a pointer to a JsonArray
   JSON_OBJECT,            // JsonVariant stores a pointer to a JsonObject
-  JSON_FLOAT              // JsonVariant stores a JsonFloat
+  JSON_FLOAT,             // JsonVariant stores a JsonFloat
+  JSON_INLINE_STRING      // JsonVariant stores a short string in its content
 };
 }
 }
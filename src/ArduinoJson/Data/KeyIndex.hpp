@@ -0,0 +1,151 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#pragma once
+
+#include "../JsonBuffer.hpp"
+#include "../JsonPair.hpp"
+#include "../StringTraits/StringTraits.hpp"
+#include "ListNode.hpp"
+
+namespace ArduinoJson {
+namespace Internals {
+
+// A hash table of the nodes of a JsonObject, allocated in the JsonBuffer.
+// It uses open addressing with linear probing, and it's never more than half
+// full. The slots only hold the nodes; the hash comes from JsonPair::keyHash.
+// It's a chain of segments: when the last one is half full, a segment twice
+// as big is appended, so the previous ones stay in use instead of being
+// abandoned in the JsonBuffer. The nodes are inserted in the order of the
+// list and the segments are searched in that order, so that the first of two
+// duplicate keys is found first, like with a linear search.
+struct KeyIndex {
+  typedef ListNode<JsonPair> node_type;
+
+  // Gets the capacity of a segment for the specified number of nodes
+  static size_t capacityFor(size_t nodeCount) {
+    size_t capacity = 4;
+    while (capacity < 2 * nodeCount) capacity <<= 1;
+    return capacity;
+  }
+
+  // Gets the number of bytes of a segment with the specified capacity
+  static size_t sizeFor(size_t capacity) {
+    return sizeof(KeyIndex) + (capacity - 1) * sizeof(node_type *);
+  }
+
+  static KeyIndex *create(JsonBuffer *buffer, size_t capacity) {
+    void *p = buffer->alloc(sizeFor(capacity));
+    if (!p) return NULL;
+    KeyIndex *index = static_cast<KeyIndex *>(p);
+    index->next = NULL;
+    index->capacity = capacity;
+    index->clearSegment();
+    return index;
+  }
+
+  // Removes all the nodes, so that they are inserted again.
+  // The segments are kept.
+  void clear() {
+    for (KeyIndex *s = this; s; s = s->next) s->clearSegment();
+  }
+
+  // Adds a node after the others.
+  // Returns false if a new segment is needed and the allocation fails.
+  bool insert(JsonBuffer *buffer, node_type *node) {
+    // the last segment that isn't empty, the following ones are
+    KeyIndex *s = this;
+    for (KeyIndex *t = next; t; t = t->next)
+      if (t->count) s = t;
+    if (2 * (s->count + 1) > s->capacity) {
+      if (!s->next) {
+        s->next = create(buffer, 2 * s->capacity);
+        if (!s->next) return false;
+      }
+      s = s->next;
+    }
+    s->insertInSegment(node);
+    last = node;
+    return true;
+  }
+
+  template <typename TStringRef>
+  node_type *find(TStringRef key) const {
+    uint32_t hash = StringTraits<TStringRef>::hash(key);
+    for (const KeyIndex *s = this; s; s = s->next) {
+      size_t mask = s->capacity - 1;
+      for (size_t i = hash & mask; s->slots[i]; i = (i + 1) & mask) {
+        const JsonPair &pair = s->slots[i]->content();
+#if ARDUINOJSON_ENABLE_KEY_HASH
+        if (pair.keyHash != hash) continue;
+#endif
+        if (StringTraits<TStringRef>::equals(key, pair.key))
+          return s->slots[i];
+      }
+    }
+    return NULL;
+  }
+
+  // Removes the node that holds the specified pair.
+  // Returns the node, or NULL if it isn't in the table.
+  node_type *remove(const JsonPair *pair) {
+    uint32_t hash = hashOf(*pair);
+    for (KeyIndex *s = this; s; s = s->next) {
+      node_type *node = s->removeFromSegment(pair, hash);
+      if (node) return node;
+    }
+    return NULL;
+  }
+
+  static uint32_t hashOf(const JsonPair &pair) {
+#if ARDUINOJSON_ENABLE_KEY_HASH
+    return pair.keyHash;
+#else
+    return hashString(pair.key);
+#endif
+  }
+
+  KeyIndex *next;
+  size_t capacity;  // a power of two
+  size_t count;
+  // The last node inserted, the next ones are not indexed.
+  // Only used in the first segment.
+  node_type *last;
+  node_type *slots[1];
+
+ private:
+  void clearSegment() {
+    count = 0;
+    last = NULL;
+    for (size_t i = 0; i < capacity; i++) slots[i] = NULL;
+  }
+
+  void insertInSegment(node_type *node) {
+    size_t mask = capacity - 1;
+    size_t i = hashOf(node->content()) & mask;
+    while (slots[i]) i = (i + 1) & mask;
+    slots[i] = node;
+    count++;
+  }
+
+  node_type *removeFromSegment(const JsonPair *pair, uint32_t hash) {
+    size_t mask = capacity - 1;
+    size_t i = hash & mask;
+    while (slots[i] && &slots[i]->content() != pair) i = (i + 1) & mask;
+    node_type *node = slots[i];
+    if (!node) return NULL;
+    // move back the following slots that would become unreachable
+    for (size_t j = (i + 1) & mask; slots[j]; j = (j + 1) & mask) {
+      size_t home = hashOf(slots[j]->content()) & mask;
+      if (((j - home) & mask) < ((j - i) & mask)) continue;
+      slots[i] = slots[j];
+      i = j;
+    }
+    slots[i] = NULL;
+    count--;
+    return node;
+  }
+};
+}
+}
@@ -0,0 +1,63 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#pragma once
+
+#include <stddef.h>  // for size_t
+#include <string.h>  // for strncmp
+
+#include "BufferedString.hpp"
+
+namespace ArduinoJson {
+namespace Internals {
+
+// Gives a canonical copy of the keys, so that identical keys share the same
+// address. Implemented by JsonKeyTable.
+class KeyInterner {
+ public:
+  // Returns the canonical copy of the string (not null-terminated on input),
+  // or NULL if it cannot be stored.
+  virtual const char* intern(const char* chars, size_t length) = 0;
+
+ protected:
+  ~KeyInterner() {}
+};
+
+// Gives the key of the previous object of an array, if it's the same as the
+// key at the same position in the current object.
+class SiblingKey {
+ public:
+  explicit SiblingKey(const char* key) : _key(key) {}
+
+  const char* intern(const char* chars, size_t length) const {
+    if (strncmp(_key, chars, length) != 0 || _key[length] != 0) return NULL;
+    return _key;
+  }
+
+ private:
+  const char* _key;
+};
+
+// A string of the parser that is looked up in a KeyInterner (or a
+// SiblingKey) before being written in the JsonBuffer.
+// Only the strings that fit in the local buffer are interned.
+template <typename TString, typename TInterner = KeyInterner>
+class InterningString : public BufferedString<TString, 64> {
+ public:
+  InterningString(TInterner* interner, TString str)
+      : BufferedString<TString, 64>(str), _interner(interner) {}
+
+  const char* c_str() {
+    if (this->isBuffered()) {
+      const char* key = _interner->intern(this->chars(), this->size());
+      if (key) return key;
+    }
+    return BufferedString<TString, 64>::c_str();
+  }
+
+ private:
+  TInterner* _interner;
+};
+}
+}
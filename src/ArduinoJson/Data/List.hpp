@@ -13,6 +13,8 @@ namespace Internals {
 
 // A singly linked list of T.
 // The linked list is composed of ListNode<T>.
+// It keeps a pointer to the last node and the number of nodes, so that add()
+// and size() run in constant time.
 // It is derived by JsonArray and JsonObject
 template <typename T>
 class List {
@@ -27,7 +29,8 @@ class List {
   // When buffer is NULL, the List is not able to grow and success() returns
   // false. This is used to identify bad memory allocations and parsing
   // failures.
-  explicit List(JsonBuffer *buffer) : _buffer(buffer), _firstNode(NULL) {}
+  explicit List(JsonBuffer *buffer)
+      : _buffer(buffer), _firstNode(NULL), _lastNode(NULL), _nodeCount(0) {}
 
   // Returns true if the object is valid
   // Would return false in the following situation:
@@ -40,21 +43,23 @@ class List {
   // Returns the numbers of elements in the list.
   // For a JsonObject, it would return the number of key-value pairs
   size_t size() const {
-    size_t nodeCount = 0;
-    for (node_type *node = _firstNode; node; node = node->next) nodeCount++;
-    return nodeCount;
+    return _nodeCount;
   }
 
   iterator add() {
     node_type *newNode = new (_buffer) node_type();
+    if (!newNode) return end();
+#if ARDUINOJSON_COMPACT_NODES
+    if (!node_type::canLinkTo(newNode)) return end();
+#endif
 
-    if (_firstNode) {
-      node_type *lastNode = _firstNode;
-      while (lastNode->next) lastNode = lastNode->next;
-      lastNode->next = newNode;
+    if (_lastNode) {
+      _lastNode->setNext(newNode);
     } else {
       _firstNode = newNode;
     }
+    _lastNode = newNode;
+    _nodeCount++;
 
     return iterator(newNode);
   }
@@ -76,19 +81,39 @@ class List {
   void remove(iterator it) {
     node_type *nodeToRemove = it._node;
     if (!nodeToRemove) return;
-    if (nodeToRemove == _firstNode) {
-      _firstNode = nodeToRemove->next;
-    } else {
-      for (node_type *node = _firstNode; node; node = node->next)
-        if (node->next == nodeToRemove) node->next = nodeToRemove->next;
+    node_type *previous = NULL;
+    if (nodeToRemove != _firstNode) {
+      previous = _firstNode;
+      while (previous && previous->next() != nodeToRemove)
+        previous = previous->next();
+      if (!previous) return;  // not in this list
     }
+    removeNext(previous);
   }
 
  protected:
+  node_type *firstNode() const {
+    return _firstNode;
+  }
+
+  // Removes the node that follows previous, or the first node if NULL
+  void removeNext(node_type *previous) {
+    node_type *node = previous ? previous->next() : _firstNode;
+    if (!node) return;
+    if (previous)
+      previous->setNext(node->next());
+    else
+      _firstNode = node->next();
+    if (node == _lastNode) _lastNode = previous;
+    _nodeCount--;
+  }
+
   JsonBuffer *_buffer;
 
  private:
   node_type *_firstNode;
+  node_type *_lastNode;
+  size_t _nodeCount;
 };
 }
 }
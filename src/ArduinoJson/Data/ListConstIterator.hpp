@@ -16,10 +16,10 @@ class ListConstIterator {
   explicit ListConstIterator(const ListNode<T> *node = NULL) : _node(node) {}
 
   const T &operator*() const {
-    return _node->content;
+    return _node->content();
   }
   const T *operator->() {
-    return &_node->content;
+    return &_node->content();
   }
 
   bool operator==(const ListConstIterator<T> &other) const {
@@ -31,13 +31,13 @@ class ListConstIterator {
   }
 
   ListConstIterator<T> &operator++() {
-    if (_node) _node = _node->next;
+    if (_node) _node = _node->next();
     return *this;
   }
 
   ListConstIterator<T> &operator+=(size_t distance) {
     while (_node && distance) {
-      _node = _node->next;
+      _node = _node->next();
       --distance;
     }
     return *this;
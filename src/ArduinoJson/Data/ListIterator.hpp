@@ -22,10 +22,10 @@ class ListIterator {
   explicit ListIterator(ListNode<T> *node = NULL) : _node(node) {}
 
   T &operator*() const {
-    return _node->content;
+    return _node->content();
   }
   T *operator->() {
-    return &_node->content;
+    return &_node->content();
   }
 
   bool operator==(const ListIterator<T> &other) const {
@@ -37,13 +37,13 @@ class ListIterator {
   }
 
   ListIterator<T> &operator++() {
-    if (_node) _node = _node->next;
+    if (_node) _node = _node->next();
     return *this;
   }
 
   ListIterator<T> &operator+=(size_t distance) {
     while (_node && distance) {
-      _node = _node->next;
+      _node = _node->next();
       --distance;
     }
     return *this;
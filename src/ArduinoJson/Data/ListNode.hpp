@@ -5,20 +5,78 @@
 #pragma once
 
 #include <stddef.h>  // for NULL
+#include <stdint.h>  // for uint16_t, uint32_t, uint64_t, uintptr_t
 
 #include "JsonBufferAllocated.hpp"
 
 namespace ArduinoJson {
 namespace Internals {
 
+#if ARDUINOJSON_COMPACT_NODES
+// A node for a singly-linked list.
+// Used by List<T> and its iterators.
+// The address of the next node is stored in 48 bits, which is enough for the
+// user space of x86-64 and AArch64. Since T is a base class, GCC and Clang
+// place it in the tail padding of T, so a ListNode<JsonVariant> takes 16
+// bytes instead of 24.
+template <typename T>
+struct ListNode : public T, public Internals::JsonBufferAllocated {
+  ListNode() throw() : T(), _nextHigh(0), _nextLow(0) {}
+
+  T &content() {
+    return *this;
+  }
+  const T &content() const {
+    return *this;
+  }
+
+  ListNode<T> *next() const {
+    uint64_t address = (static_cast<uint64_t>(_nextHigh) << 32) | _nextLow;
+    return reinterpret_cast<ListNode<T> *>(static_cast<uintptr_t>(address));
+  }
+
+  void setNext(ListNode<T> *node) {
+    uint64_t address = reinterpret_cast<uintptr_t>(node);
+    _nextHigh = static_cast<uint16_t>(address >> 32);
+    _nextLow = static_cast<uint32_t>(address);
+  }
+
+  // Tells whether the address of the node fits in 48 bits
+  static bool canLinkTo(const ListNode<T> *node) {
+    return (static_cast<uint64_t>(reinterpret_cast<uintptr_t>(node)) >> 48) ==
+           0;
+  }
+
+ private:
+  uint16_t _nextHigh;
+  uint32_t _nextLow;
+};
+#else
 // A node for a singly-linked list.
 // Used by List<T> and its iterators.
 template <typename T>
 struct ListNode : public Internals::JsonBufferAllocated {
-  ListNode() throw() : next(NULL) {}
+  ListNode() throw() : _next(NULL) {}
+
+  T &content() {
+    return _content;
+  }
+  const T &content() const {
+    return _content;
+  }
+
+  ListNode<T> *next() const {
+    return _next;
+  }
+
+  void setNext(ListNode<T> *node) {
+    _next = node;
+  }
 
-  ListNode<T> *next;
-  T content;
+ private:
+  ListNode<T> *_next;
+  T _content;
 };
+#endif
 }
 }
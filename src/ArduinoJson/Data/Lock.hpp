@@ -0,0 +1,37 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#pragma once
+
+namespace ArduinoJson {
+namespace Internals {
+
+// A mutex that does nothing.
+// Used when an object is not shared between threads.
+// Any type with lock() and unlock(), like std::mutex, can be used instead.
+class NoMutex {
+ public:
+  void lock() {}
+  void unlock() {}
+};
+
+// Locks a mutex for the lifetime of the object
+template <typename TMutex>
+class Lock {
+ public:
+  explicit Lock(TMutex& mutex) : _mutex(mutex) {
+    _mutex.lock();
+  }
+  ~Lock() {
+    _mutex.unlock();
+  }
+
+ private:
+  Lock(const Lock&);
+  Lock& operator=(const Lock&);
+
+  TMutex& _mutex;
+};
+}
+}
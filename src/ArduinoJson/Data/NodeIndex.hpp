@@ -0,0 +1,84 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#pragma once
+
+#include "../JsonBuffer.hpp"
+#include "../JsonVariant.hpp"
+#include "ListNode.hpp"
+
+namespace ArduinoJson {
+namespace Internals {
+
+// The addresses of the nodes of a JsonArray, in order, allocated in the
+// JsonBuffer.
+// It's a chain of segments: when the last one is full, a segment twice as big
+// is appended, so the previous ones stay in use instead of being abandoned in
+// the JsonBuffer.
+struct NodeIndex {
+  typedef ListNode<JsonVariant> node_type;
+
+  static NodeIndex *create(JsonBuffer *buffer, size_t capacity) {
+    void *p = buffer->alloc(sizeof(NodeIndex) +
+                            (capacity - 1) * sizeof(node_type *));
+    if (!p) return NULL;
+    NodeIndex *index = static_cast<NodeIndex *>(p);
+    index->next = NULL;
+    index->capacity = capacity;
+    index->count = 0;
+    return index;
+  }
+
+  // Gets the number of nodes in all the segments
+  size_t size() const {
+    size_t total = 0;
+    for (const NodeIndex *s = this; s; s = s->next) total += s->count;
+    return total;
+  }
+
+  // Gets the node at the specified position, or NULL if it's not indexed
+  node_type *find(size_t position) const {
+    for (const NodeIndex *s = this; s; s = s->next) {
+      if (position < s->count) return s->nodes[position];
+      position -= s->count;
+    }
+    return NULL;
+  }
+
+  // Adds a node after the others.
+  // Returns false if a new segment is needed and the allocation fails.
+  bool add(JsonBuffer *buffer, node_type *node) {
+    // the last segment that isn't empty, the following ones are
+    NodeIndex *s = this;
+    for (NodeIndex *t = next; t; t = t->next)
+      if (t->count) s = t;
+    if (s->count == s->capacity) {
+      if (!s->next) {
+        s->next = create(buffer, 2 * s->capacity);
+        if (!s->next) return false;
+      }
+      s = s->next;
+    }
+    s->nodes[s->count++] = node;
+    return true;
+  }
+
+  void remove(const JsonVariant *value) {
+    for (NodeIndex *s = this; s; s = s->next) {
+      for (size_t i = 0; i < s->count; i++) {
+        if (&s->nodes[i]->content() != value) continue;
+        s->count--;
+        for (; i < s->count; i++) s->nodes[i] = s->nodes[i + 1];
+        return;
+      }
+    }
+  }
+
+  NodeIndex *next;
+  size_t capacity;
+  size_t count;
+  node_type *nodes[1];
+};
+}
+}
@@ -0,0 +1,179 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#pragma once
+
+#include "../JsonBuffer.hpp"
+#include "../JsonVariant.hpp"
+#include "../Polyfills/ctype.hpp"
+#include "../Polyfills/isFloat.hpp"
+#include "../Polyfills/parseFloat.hpp"
+#include "../Polyfills/parseInteger.hpp"
+#include "JsonFloat.hpp"
+#include "JsonInteger.hpp"
+
+namespace ArduinoJson {
+namespace Internals {
+
+// The values of a JsonArray that contains only numbers, stored contiguously
+// instead of in a list of JsonVariant (see ARDUINOJSON_ENABLE_PACKED_ARRAYS).
+// The values are stored in chunks allocated in the JsonBuffer; the capacity
+// of the chunks doubles from 8 to 1024 values.
+// The values are integers until a float is added; then they are all floats.
+class PackedNumbers {
+ public:
+  union Value {
+    JsonInteger asInteger;
+    JsonFloat asFloat;
+  };
+
+  struct Chunk {
+    Chunk *next;
+    size_t count;
+    size_t capacity;
+    Value values[1];
+  };
+
+  enum { FirstChunkCapacity = 8, MaxChunkCapacity = 1024 };
+
+  PackedNumbers() : _head(NULL), _tail(NULL), _count(0), _isFloat(false) {}
+
+  // Gets the number of bytes of a chunk with the specified capacity
+  static size_t chunkSize(size_t capacity) {
+    return sizeof(Chunk) + (capacity - 1) * sizeof(Value);
+  }
+
+  // Gets the capacity of the chunk that follows a chunk of the specified
+  // capacity (0 = no chunk yet)
+  static size_t nextChunkCapacity(size_t capacity) {
+    if (!capacity) return FirstChunkCapacity;
+    return capacity < MaxChunkCapacity ? 2 * capacity : capacity;
+  }
+
+  // Parses a number, as written by the parser.
+  // Returns false if the string is not a number, or if it's an integer that
+  // doesn't fit in a JsonInteger.
+  static bool parse(const char *s, Value &value, bool &isFloatValue) {
+    const char *digits = s;
+    if (issign(*digits)) digits++;
+    size_t length = 0;
+    while (isdigit(digits[length])) length++;
+    if (length > 0 && digits[length] == '\0') {
+      isFloatValue = false;
+      return parseInteger(s, value.asInteger);
+    }
+    if (!Internals::isFloat(s) || !hasDigit(s)) return false;
+    value.asFloat = parseFloat<JsonFloat>(s);
+    isFloatValue = true;
+    return true;
+  }
+
+  size_t size() const {
+    return _count;
+  }
+
+  bool isFloat() const {
+    return _isFloat;
+  }
+
+  // Returns false if the allocation of a chunk fails
+  bool add(JsonBuffer *buffer, Value value, bool isFloatValue) {
+    if (!_tail || _tail->count == _tail->capacity) {
+      size_t capacity = nextChunkCapacity(_tail ? _tail->capacity : 0);
+      Chunk *chunk = static_cast<Chunk *>(buffer->alloc(chunkSize(capacity)));
+      if (!chunk) return false;
+      chunk->next = NULL;
+      chunk->count = 0;
+      chunk->capacity = capacity;
+      if (_tail)
+        _tail->next = chunk;
+      else
+        _head = chunk;
+      _tail = chunk;
+    }
+    if (isFloatValue && !_isFloat) convertToFloats();
+    if (!isFloatValue && _isFloat)
+      value.asFloat = static_cast<JsonFloat>(value.asInteger);
+    _tail->values[_tail->count++] = value;
+    _count++;
+    return true;
+  }
+
+  // Copies the values of another instance in a single chunk
+  bool copy(JsonBuffer *buffer, const PackedNumbers &src) {
+    clear();
+    if (!src._count) return true;
+    Chunk *chunk = static_cast<Chunk *>(buffer->alloc(chunkSize(src._count)));
+    if (!chunk) return false;
+    chunk->next = NULL;
+    chunk->count = 0;
+    chunk->capacity = src._count;
+    for (Chunk *c = src._head; c; c = c->next)
+      for (size_t i = 0; i < c->count; i++)
+        chunk->values[chunk->count++] = c->values[i];
+    _head = _tail = chunk;
+    _count = src._count;
+    _isFloat = src._isFloat;
+    return true;
+  }
+
+  // Gets the values stored contiguously from the specified index.
+  // Returns the number of values, 0 if the index is out of range.
+  // It walks the chunks, whose capacity doubles, from the first one; to read
+  // all the values in order, use JsonArray::const_iterator.
+  size_t getContiguous(size_t index, const Value *&values) const {
+    for (const Chunk *chunk = _head; chunk; chunk = chunk->next) {
+      if (index < chunk->count) {
+        values = chunk->values + index;
+        return chunk->count - index;
+      }
+      index -= chunk->count;
+    }
+    return 0;
+  }
+
+  JsonVariant get(size_t index) const {
+    const Value *value;
+    if (!getContiguous(index, value)) return JsonVariant();
+    return toVariant(*value);
+  }
+
+  JsonVariant toVariant(const Value &value) const {
+    if (_isFloat) return JsonVariant(value.asFloat);
+    return JsonVariant(value.asInteger);
+  }
+
+  const Chunk *firstChunk() const {
+    return _head;
+  }
+
+  // Forgets the values; the memory stays in the JsonBuffer
+  void clear() {
+    _head = _tail = NULL;
+    _count = 0;
+    _isFloat = false;
+  }
+
+ private:
+  static bool hasDigit(const char *s) {
+    while (*s)
+      if (isdigit(*s++)) return true;
+    return false;
+  }
+
+  void convertToFloats() {
+    for (Chunk *chunk = _head; chunk; chunk = chunk->next)
+      for (size_t i = 0; i < chunk->count; i++)
+        chunk->values[i].asFloat =
+            static_cast<JsonFloat>(chunk->values[i].asInteger);
+    _isFloat = true;
+  }
+
+  Chunk *_head;
+  Chunk *_tail;
+  size_t _count;
+  bool _isFloat;
+};
+}
+}
@@ -4,8 +4,28 @@
 
 #pragma once
 
+#include "../Polyfills/scanSpaces.hpp"
+
 namespace ArduinoJson {
 namespace Internals {
+// Skips the current space, or the whole run of spaces when the input is
+// contiguous and the vector instructions can scan it.
+// The first spaces are skipped one by one, because the short runs, like
+// after a colon, are cheaper to skip without the vector instructions.
+template <typename TInput>
+inline void skipSpaces(TInput& input) {
+  input.move();
+#if ARDUINOJSON_HAS_SSE2
+  for (int i = 0; i < 4; i++) {
+    if (!isSpace(input.current())) return;
+    input.move();
+  }
+  const char* chars;
+  size_t available = input.peek(chars);
+  input.skip(scanSpaces(chars, available));
+#endif
+}
+
 template <typename TInput>
 void skipSpacesAndComments(TInput& input) {
   for (;;) {
@@ -15,7 +35,7 @@ void skipSpacesAndComments(TInput& input) {
       case '\t':
       case '\r':
       case '\n':
-        input.move();
+        skipSpaces(input);
         continue;
 
       // comments
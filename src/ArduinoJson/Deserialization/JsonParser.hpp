@@ -5,9 +5,14 @@
 #pragma once
 
 #include "../JsonBuffer.hpp"
+#include "../Data/InlineString.hpp"
+#include "../Data/KeyInterner.hpp"
 #include "../JsonVariant.hpp"
+#include "../Polyfills/scanString.hpp"
+#include "../Polyfills/scanToken.hpp"
 #include "../TypeTraits/IsConst.hpp"
 #include "StringWriter.hpp"
+#include "decodeLiteral.hpp"
 
 namespace ArduinoJson {
 namespace Internals {
@@ -23,7 +28,13 @@ class JsonParser {
       : _buffer(buffer),
         _reader(reader),
         _writer(writer),
-        _nestingLimit(nestingLimit) {}
+        _nestingLimit(nestingLimit)
+#if ARDUINOJSON_REUSE_SIBLING_KEYS
+        ,
+        _sibling(NULL)
+#endif
+  {
+  }
 
   JsonArray &parseArray();
   JsonObject &parseObject();
@@ -34,6 +45,13 @@ class JsonParser {
     return result;
   }
 
+  // Reads the input like parseVariant(), but only tells the writer (a
+  // JsonSizer) what parseVariant() would allocate.
+  // Defined in JsonSizerImpl.hpp
+  bool measureVariant() {
+    return measureAnything(NULL);
+  }
+
  private:
   JsonParser &operator=(const JsonParser &);  // non-copiable
 
@@ -43,19 +61,79 @@ class JsonParser {
   }
 
   const char *parseString();
+  const char *parseKey(const char *siblingKey);
+  template <typename TInterner>
+  const char *parseKeyWith(TInterner *interner);
+  template <typename TString>
+  FORCE_INLINE void readString(TString &str) {
+    readString(_reader, str);
+  }
+  template <typename TString>
+  static void readString(TReader &, TString &str);
   bool parseAnythingTo(JsonVariant *destination);
 
   inline bool parseArrayTo(JsonVariant *destination);
   inline bool parseObjectTo(JsonVariant *destination);
   inline bool parseStringTo(JsonVariant *destination);
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+  enum PackingResult { NOT_A_NUMBER, PACKED, NOT_PACKED, PACKING_FAILED };
+  inline PackingResult parsePackedNumberTo(JsonArray &array,
+                                           JsonVariant *destination);
+#endif
+#if ARDUINOJSON_DECODE_LITERALS
+  inline bool parseLiteralTo(JsonVariant *destination);
+#endif
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS || ARDUINOJSON_DECODE_LITERALS
+  enum { MaxTokenLength = 63 };
+  inline size_t readToken(char *token);
+  inline bool parseTokenTo(const char *token, size_t length,
+                           JsonVariant *destination);
+#endif
+
+  bool measureAnything(const TReader *sibling);
+  bool measureArray();
+  bool measureObject(const TReader *sibling);
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+  // What the packed values of an array use
+  struct PackedSize {
+    size_t count;          // the values, until they're unpacked
+    size_t chunkCapacity;  // 0 = no chunk yet
+    size_t chunkCount;
+  };
+  PackingResult measurePackedNumber(PackedSize &packed, size_t &nodes);
+#endif
+#if ARDUINOJSON_REUSE_SIBLING_KEYS
+  // The keys of the previous object of an array, read again in the input
+  struct SiblingKeys {
+    explicit SiblingKeys(const TReader &start)
+        : object(start), next(start), index(0), hasDuplicates(false) {}
+
+    TReader object;  // at the '{'
+    TReader next;    // after the last key returned
+    size_t index;    // the number of keys read so far
+    bool hasDuplicates;
+  };
+  static bool nextSiblingKey(SiblingKeys &keys, TReader &key);
+  static bool nextKey(TReader &cursor, TReader &key);
+  static void skipValue(TReader &);
+#if ARDUINOJSON_REMOVE_DUPLICATE_KEYS
+  static bool hasDuplicateKeys(const TReader &object);
+  static bool isDuplicateKey(const TReader &object, const TReader &key,
+                             size_t index);
+  static bool sameKey(const TReader &a, const TReader &b);
+#endif
+#endif
 
   static inline bool isBetween(char c, char min, char max) {
     return min <= c && c <= max;
   }
 
   static inline bool canBeInNonQuotedString(char c) {
-    return isBetween(c, '0', '9') || isBetween(c, '_', 'z') ||
-           isBetween(c, 'A', 'Z') || c == '+' || c == '-' || c == '.';
+    return isTokenChar(c);
+  }
+
+  static inline bool isNumberStart(char c) {
+    return isBetween(c, '0', '9') || c == '-' || c == '+' || c == '.';
   }
 
   static inline bool isQuote(char c) {
@@ -66,6 +144,10 @@ class JsonParser {
   TReader _reader;
   TWriter _writer;
   uint8_t _nestingLimit;
+#if ARDUINOJSON_REUSE_SIBLING_KEYS
+  // The previous object of the array, given to the next parseObject()
+  const JsonObject *_sibling;
+#endif
 };
 
 template <typename TJsonBuffer, typename TString, typename Enable = void>
@@ -48,13 +48,40 @@ ArduinoJson::Internals::JsonParser<TReader, TWriter>::parseArray() {
   if (eat(']')) goto SUCCESS_EMPTY_ARRAY;
 
   // Read each value
-  for (;;) {
+  for (const JsonObject *sibling = NULL;;) {
     // 1 - Parse value
     JsonVariant value;
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+    switch (parsePackedNumberTo(array, &value)) {
+      case PACKED:
+        goto MORE_VALUES;
+      case NOT_PACKED:
+        goto ADD_VALUE;
+      case PACKING_FAILED:
+        goto ERROR_NO_MEMORY;
+      case NOT_A_NUMBER:
+        break;
+    }
+#endif
+#if ARDUINOJSON_REUSE_SIBLING_KEYS
+    _sibling = sibling;
+#endif
     if (!parseAnythingTo(&value)) goto ERROR_INVALID_VALUE;
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+  ADD_VALUE:
+#endif
     if (!array.add(value)) goto ERROR_NO_MEMORY;
+#if ARDUINOJSON_REUSE_SIBLING_KEYS
+    _sibling = NULL;
+    sibling = value.is<JsonObject>() ? &value.as<JsonObject>() : NULL;
+#else
+    (void)sibling;
+#endif
 
     // 2 - More values?
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+  MORE_VALUES:
+#endif
     if (eat(']')) goto SUCCES_NON_EMPTY_ARRAY;
     if (!eat(',')) goto ERROR_MISSING_COMMA;
   }
@@ -90,6 +117,13 @@ ArduinoJson::Internals::JsonParser<TReader, TWriter>::parseObject() {
   // Create an empty object
   JsonObject &object = _buffer->createObject();
 
+  // The keys of the previous object of the array, if any
+  JsonObject::const_iterator siblingKey;
+#if ARDUINOJSON_REUSE_SIBLING_KEYS
+  if (_sibling) siblingKey = _sibling->begin();
+  _sibling = NULL;
+#endif
+
   // Check opening brace
   if (!eat('{')) goto ERROR_MISSING_BRACE;
   if (eat('}')) goto SUCCESS_EMPTY_OBJECT;
@@ -97,22 +131,27 @@ ArduinoJson::Internals::JsonParser<TReader, TWriter>::parseObject() {
   // Read each key value pair
   for (;;) {
     // 1 - Parse key
-    const char *key = parseString();
+    const char *key = parseKey(
+        siblingKey != JsonObject::const_iterator() ? siblingKey->key : NULL);
     if (!key) goto ERROR_INVALID_KEY;
+    ++siblingKey;
     if (!eat(':')) goto ERROR_MISSING_COLON;
 
     // 2 - Parse value
     JsonVariant value;
     if (!parseAnythingTo(&value)) goto ERROR_INVALID_VALUE;
-    if (!object.set(key, value)) goto ERROR_NO_MEMORY;
+    if (!object.append(key, value)) goto ERROR_NO_MEMORY;
 
     // 3 - More keys/values?
     if (eat('}')) goto SUCCESS_NON_EMPTY_OBJECT;
     if (!eat(',')) goto ERROR_MISSING_COMMA;
   }
 
-SUCCESS_EMPTY_OBJECT:
 SUCCESS_NON_EMPTY_OBJECT:
+#if ARDUINOJSON_REMOVE_DUPLICATE_KEYS
+  object.removeDuplicateKeys();
+#endif
+SUCCESS_EMPTY_OBJECT:
   _nestingLimit++;
   return object;
 
@@ -139,45 +178,203 @@ template <typename TReader, typename TWriter>
 inline const char *
 ArduinoJson::Internals::JsonParser<TReader, TWriter>::parseString() {
   typename RemoveReference<TWriter>::type::String str = _writer.startString();
+  readString(str);
+  return str.c_str();
+}
 
-  skipSpacesAndComments(_reader);
-  char c = _reader.current();
+template <typename TReader, typename TWriter>
+inline const char *
+ArduinoJson::Internals::JsonParser<TReader, TWriter>::parseKey(
+    const char *siblingKey) {
+#if ARDUINOJSON_ENABLE_KEY_TABLE
+  if (_buffer->keyTable()) return parseKeyWith(_buffer->keyTable());
+#endif
+#if ARDUINOJSON_REUSE_SIBLING_KEYS
+  if (siblingKey) {
+    SiblingKey sibling(siblingKey);
+    return parseKeyWith(&sibling);
+  }
+#else
+  (void)siblingKey;
+#endif
+  return parseString();
+}
+
+template <typename TReader, typename TWriter>
+template <typename TInterner>
+inline const char *
+ArduinoJson::Internals::JsonParser<TReader, TWriter>::parseKeyWith(
+    TInterner *interner) {
+  typedef typename RemoveReference<TWriter>::type::String TString;
+  InterningString<TString, TInterner> str(interner, _writer.startString());
+  readString(str);
+  return str.c_str();
+}
+
+template <typename TReader, typename TWriter>
+template <typename TString>
+inline void ArduinoJson::Internals::JsonParser<TReader, TWriter>::readString(
+    TReader &reader, TString &str) {
+  skipSpacesAndComments(reader);
+  char c = reader.current();
 
   if (isQuote(c)) {  // quotes
-    _reader.move();
+    reader.move();
     char stopChar = c;
     for (;;) {
-      c = _reader.current();
+      // copy the characters that need no unescaping at once
+      const char *chars;
+      size_t available = reader.peek(chars);
+      size_t length = scanString(chars, available, stopChar);
+      if (length) {
+        str.append(chars, length);
+        reader.skip(length);
+      }
+
+      c = reader.current();
       if (c == '\0') break;
-      _reader.move();
+      reader.move();
 
       if (c == stopChar) break;
 
       if (c == '\\') {
         // replace char
-        c = Encoding::unescapeChar(_reader.current());
+        c = Encoding::unescapeChar(reader.current());
         if (c == '\0') break;
-        _reader.move();
+        reader.move();
       }
 
       str.append(c);
     }
   } else {  // no quotes
     for (;;) {
+      // copy the characters up to the next structural character at once
+      const char *chars;
+      size_t available = reader.peek(chars);
+      size_t length = scanToken(chars, available);
+      if (length) {
+        str.append(chars, length);
+        reader.skip(length);
+      }
+
+      c = reader.current();
       if (!canBeInNonQuotedString(c)) break;
-      _reader.move();
+      reader.move();
       str.append(c);
-      c = _reader.current();
     }
   }
+}
 
-  return str.c_str();
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+// Parses a value of an array that has no JsonVariant yet.
+// A number is added to the packed values of the array. Anything else unpacks
+// the array: a value that starts like a number is then stored in destination,
+// like parseStringTo() would; the other values are left to parseAnythingTo().
+template <typename TReader, typename TWriter>
+inline typename ArduinoJson::Internals::JsonParser<TReader,
+                                                   TWriter>::PackingResult
+ArduinoJson::Internals::JsonParser<TReader, TWriter>::parsePackedNumberTo(
+    JsonArray &array, JsonVariant *destination) {
+  if (array.Internals::List<JsonVariant>::size() > 0) return NOT_A_NUMBER;
+
+  skipSpacesAndComments(_reader);
+  char token[MaxTokenLength + 1];
+  size_t length = 0;
+
+  if (isNumberStart(_reader.current())) {
+    length = readToken(token);
+    PackedNumbers::Value number;
+    bool isFloat;
+    if (!canBeInNonQuotedString(_reader.current()) &&
+        PackedNumbers::parse(token, number, isFloat))
+      return array._packed.add(_buffer, number, isFloat) ? PACKED
+                                                         : PACKING_FAILED;
+  }
+
+  if (!array.unpack()) return PACKING_FAILED;
+  if (length == 0) return NOT_A_NUMBER;
+  return parseTokenTo(token, length, destination) ? NOT_PACKED
+                                                  : PACKING_FAILED;
+}
+#endif
+
+#if ARDUINOJSON_DECODE_LITERALS
+// Parses an unquoted value: true, false, null and the numbers are converted,
+// the other values are stored like parseStringTo() would.
+template <typename TReader, typename TWriter>
+inline bool ArduinoJson::Internals::JsonParser<TReader, TWriter>::parseLiteralTo(
+    JsonVariant *destination) {
+  char token[MaxTokenLength + 1];
+  size_t length = readToken(token);
+  if (!canBeInNonQuotedString(_reader.current()) &&
+      decodeLiteral(token, destination))
+    return true;
+  return parseTokenTo(token, length, destination);
 }
+#endif
+
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS || ARDUINOJSON_DECODE_LITERALS
+// Reads the first MaxTokenLength chars of an unquoted value.
+// Returns the length; the value is longer if the next char can be in an
+// unquoted value.
+template <typename TReader, typename TWriter>
+inline size_t ArduinoJson::Internals::JsonParser<TReader, TWriter>::readToken(
+    char *token) {
+  const char *chars;
+  size_t available = _reader.peek(chars);
+  if (available > MaxTokenLength) available = MaxTokenLength;
+  size_t length = scanToken(chars, available);
+  if (length) {
+    memcpy(token, chars, length);
+    _reader.skip(length);
+  }
+
+  char c = _reader.current();
+  while (canBeInNonQuotedString(c) && length < MaxTokenLength) {
+    token[length++] = c;
+    _reader.move();
+    c = _reader.current();
+  }
+  token[length] = '\0';
+  return length;
+}
+
+// Stores a value read by readToken() as a RawJson, with the rest of the value
+template <typename TReader, typename TWriter>
+inline bool ArduinoJson::Internals::JsonParser<TReader, TWriter>::parseTokenTo(
+    const char *token, size_t length, JsonVariant *destination) {
+  typename RemoveReference<TWriter>::type::String str = _writer.startString();
+  str.append(token, length);
+  if (canBeInNonQuotedString(_reader.current())) readString(str);
+  const char *value = str.c_str();
+  if (value == NULL) return false;
+  *destination = RawJson(value);
+  return true;
+}
+#endif
 
 template <typename TReader, typename TWriter>
 inline bool ArduinoJson::Internals::JsonParser<TReader, TWriter>::parseStringTo(
     JsonVariant *destination) {
   bool hasQuotes = isQuote(_reader.current());
+#if ARDUINOJSON_DECODE_LITERALS
+  if (!hasQuotes) return parseLiteralTo(destination);
+#endif
+#if ARDUINOJSON_ENABLE_INLINE_STRINGS
+  if (hasQuotes) {
+    typedef typename RemoveReference<TWriter>::type::String TString;
+    InlineString<TString> str(_writer.startString());
+    readString(str);
+    if (str.fits()) {
+      destination->setInlineString(str.chars(), str.size());
+      return true;
+    }
+    const char *value = str.c_str();
+    if (value == NULL) return false;
+    *destination = value;
+    return true;
+  }
+#endif
   const char *value = parseString();
   if (value == NULL) return false;
   if (hasQuotes) {
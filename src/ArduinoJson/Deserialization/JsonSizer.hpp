@@ -0,0 +1,115 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#pragma once
+
+#include "../JsonBuffer.hpp"
+#include "../TypeTraits/IsConst.hpp"
+#include "JsonParser.hpp"
+
+namespace ArduinoJson {
+namespace Internals {
+
+// Counts the bytes a StaticJsonBuffer would use, alignment padding included,
+// without allocating anything.
+// JsonParser::measureVariant() reads the input and tells it what the parser
+// would allocate; the strings are counted instead of being written.
+// This internal class is not indended to be used directly.
+// Instead, use measureJsonBufferSize()
+class JsonSizer {
+ public:
+  // A string of the parser that is only counted
+  class String {
+   public:
+    String(JsonSizer *parent) : _parent(parent) {}
+
+    void append(char) {
+      _parent->countString(1);
+    }
+
+    void append(const char *, size_t length) {
+      _parent->countString(length);
+    }
+
+    // The characters are not kept, so any non-NULL string does
+    const char *c_str() {
+      _parent->countString(1);
+      return "";
+    }
+
+   private:
+    JsonSizer *_parent;
+  };
+
+  // The strings are counted only if the parser would copy them
+  explicit JsonSizer(bool copyStrings) : _copyStrings(copyStrings), _size(0) {}
+
+  // Gets the number of bytes counted so far
+  size_t size() const {
+    return _size;
+  }
+
+  // Counts a block of the JsonBuffer
+  void alloc(size_t bytes) {
+    _size = round_size_up(_size) + bytes;
+  }
+
+  String startString() {
+    return String(this);
+  }
+
+ private:
+  // Strings are not aligned, they take the length plus the terminator
+  void countString(size_t bytes) {
+    if (_copyStrings) _size += bytes;
+  }
+
+  bool _copyStrings;
+  size_t _size;
+};
+
+// The strings are copied in the JsonBuffer, unless the input is writable,
+// exactly like in JsonParserBuilder.
+// The input is always read as const, so that it's never modified.
+template <typename TString>
+inline size_t measureJsonBufferSize(const TString &json, bool copyStrings,
+                                    uint8_t nestingLimit) {
+  typedef typename StringTraits<TString>::Reader TReader;
+  JsonSizer sizer(copyStrings);
+  JsonParser<TReader, JsonSizer &> parser(NULL, TReader(json), sizer,
+                                          nestingLimit);
+  return parser.measureVariant() ? sizer.size() : 0;
+}
+}  // namespace Internals
+
+// Computes the number of bytes that JsonBuffer::parse(), parseArray() or
+// parseObject() would use in a StaticJsonBuffer, or in a DynamicJsonBuffer
+// whose first block is big enough.
+// Returns 0 if the input is invalid.
+// It reads the input without allocating anything.
+// The keys taken from a JsonKeyTable use no room in the JsonBuffer, so the
+// value is an upper bound for a JsonBuffer with a key table.
+//
+// size_t measureJsonBufferSize(TString);
+// TString = const std::string&, const String&
+template <typename TString>
+inline typename Internals::EnableIf<!Internals::IsArray<TString>::value,
+                                    size_t>::type
+measureJsonBufferSize(
+    const TString &json,
+    uint8_t nestingLimit = ARDUINOJSON_DEFAULT_NESTING_LIMIT) {
+  return Internals::measureJsonBufferSize(json, true, nestingLimit);
+}
+//
+// size_t measureJsonBufferSize(TString);
+// TString = const char*, const char[N], const FlashStringHelper*, char*
+template <typename TString>
+inline size_t measureJsonBufferSize(
+    TString *json, uint8_t nestingLimit = ARDUINOJSON_DEFAULT_NESTING_LIMIT) {
+  const TString *input = json;
+  return Internals::measureJsonBufferSize(
+      input, Internals::IsConst<TString>::value, nestingLimit);
+}
+}  // namespace ArduinoJson
+
@@ -0,0 +1,359 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#pragma once
+
+#include <string.h>  // for memcpy and strcmp
+
+#include "../Data/KeyIndex.hpp"
+#include "../Polyfills/hash.hpp"
+#include "JsonParser.hpp"
+
+// The functions of JsonParser that measure the input for JsonSizer.
+// They read the input like parseArray() and parseObject(), and tell the
+// writer about each allocation of these functions, in the same order; nothing
+// is stored, so the input is read again where the parser would read what it
+// already stored: the keys of the previous object of an array.
+
+namespace ArduinoJson {
+namespace Internals {
+
+// A string of the parser that only keeps N characters from the specified
+// position, and its length
+template <size_t N>
+class StringWindow {
+ public:
+  explicit StringWindow(size_t position = 0)
+      : _position(position), _length(0) {}
+
+  void append(char c) {
+    append(&c, 1);
+  }
+
+  void append(const char *chars, size_t length) {
+    size_t end = _position + N;
+    if (_length < end && _length + length > _position) {
+      size_t from = _length < _position ? _position - _length : 0;
+      size_t to = _length + length < end ? length : end - _length;
+      memcpy(_chars + _length + from - _position, chars + from, to - from);
+    }
+    _length += length;
+  }
+
+  // Gets the characters in the window
+  const char *c_str() {
+    size_t count = 0;
+    if (_length > _position) count = _length - _position;
+    if (count > N) count = N;
+    _chars[count] = 0;
+    return _chars;
+  }
+
+  size_t size() const {
+    return _length;
+  }
+
+ private:
+  size_t _position;
+  size_t _length;
+  char _chars[N + 1];
+};
+}
+}
+
+template <typename TReader, typename TWriter>
+inline bool
+ArduinoJson::Internals::JsonParser<TReader, TWriter>::measureAnything(
+    const TReader *sibling) {
+  skipSpacesAndComments(_reader);
+
+  switch (_reader.current()) {
+    case '[':
+      return measureArray();
+
+    case '{':
+      return measureObject(sibling);
+
+    default: {
+      JsonVariant value;
+      return parseStringTo(&value);
+    }
+  }
+}
+
+template <typename TReader, typename TWriter>
+inline bool
+ArduinoJson::Internals::JsonParser<TReader, TWriter>::measureArray() {
+  if (_nestingLimit == 0) return false;
+  _nestingLimit--;
+
+  _writer.alloc(sizeof(JsonArray));
+
+  if (!eat('[')) return false;
+  if (!eat(']')) {
+    // the previous value, if it's an object
+    TReader previous = _reader;
+    const TReader *sibling = NULL;
+    size_t nodes = 0;
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+    PackedSize packed = {0, 0, 0};
+#endif
+
+    for (;;) {
+      skipSpacesAndComments(_reader);
+      TReader value = _reader;
+      bool isPacked = false;
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+      PackingResult packing = NOT_A_NUMBER;
+      if (!nodes) packing = measurePackedNumber(packed, nodes);
+      if (packing == PACKING_FAILED) return false;
+      isPacked = packing == PACKED;
+      if (packing == NOT_A_NUMBER && !measureAnything(sibling)) return false;
+#else
+      if (!measureAnything(sibling)) return false;
+#endif
+
+      if (!isPacked) {
+        _writer.alloc(sizeof(JsonArray::node_type));
+        nodes++;
+        if (value.current() == '{') {
+          previous = value;
+          sibling = &previous;
+        } else {
+          sibling = NULL;
+        }
+      }
+
+      if (eat(']')) break;
+      if (!eat(',')) return false;
+    }
+  }
+
+  _nestingLimit++;
+  return true;
+}
+
+template <typename TReader, typename TWriter>
+inline bool
+ArduinoJson::Internals::JsonParser<TReader, TWriter>::measureObject(
+    const TReader *sibling) {
+  if (_nestingLimit == 0) return false;
+  _nestingLimit--;
+
+  _writer.alloc(sizeof(JsonObject));
+
+#if ARDUINOJSON_REUSE_SIBLING_KEYS
+  SiblingKeys siblingKeys(sibling ? *sibling : _reader);
+#if ARDUINOJSON_REMOVE_DUPLICATE_KEYS
+  // the previous object keeps the first occurrence of each key
+  if (sibling) siblingKeys.hasDuplicates = hasDuplicateKeys(*sibling);
+#endif
+#else
+  (void)sibling;
+#endif
+
+  if (!eat('{')) return false;
+  if (!eat('}')) {
+    size_t pairs = 0;
+    for (;;) {
+#if ARDUINOJSON_REUSE_SIBLING_KEYS
+      typedef typename RemoveReference<TWriter>::type::String TString;
+      TReader siblingKey = _reader;
+      if (sibling && nextSiblingKey(siblingKeys, siblingKey)) {
+        // like SiblingKey, with the first characters of the previous key
+        StringWindow<InterningString<TString>::MaxLength + 1> previousKey;
+        readString(siblingKey, previousKey);
+        SiblingKey interner(previousKey.c_str());
+        parseKeyWith(&interner);
+      } else {
+        sibling = NULL;
+        parseString();
+      }
+#else
+      parseString();
+#endif
+      if (!eat(':')) return false;
+
+      if (!measureAnything(NULL)) return false;
+      _writer.alloc(sizeof(JsonObject::node_type));
+      pairs++;
+
+      if (eat('}')) break;
+      if (!eat(',')) return false;
+    }
+
+#if ARDUINOJSON_REMOVE_DUPLICATE_KEYS && ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+    // the hash table of removeDuplicateKeys()
+    if (pairs >= ARDUINOJSON_OBJECT_INDEX_THRESHOLD)
+      _writer.alloc(KeyIndex::sizeFor(KeyIndex::capacityFor(pairs)));
+#else
+    (void)pairs;
+#endif
+  }
+
+  _nestingLimit++;
+  return true;
+}
+
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+// Measures parsePackedNumberTo()
+template <typename TReader, typename TWriter>
+inline typename ArduinoJson::Internals::JsonParser<TReader,
+                                                   TWriter>::PackingResult
+ArduinoJson::Internals::JsonParser<TReader, TWriter>::measurePackedNumber(
+    PackedSize &packed, size_t &nodes) {
+  skipSpacesAndComments(_reader);
+  char token[MaxTokenLength + 1];
+  size_t length = 0;
+
+  if (isNumberStart(_reader.current())) {
+    length = readToken(token);
+    PackedNumbers::Value number;
+    bool isFloat;
+    if (!canBeInNonQuotedString(_reader.current()) &&
+        PackedNumbers::parse(token, number, isFloat)) {
+      if (packed.chunkCount == packed.chunkCapacity) {
+        packed.chunkCapacity =
+            PackedNumbers::nextChunkCapacity(packed.chunkCapacity);
+        packed.chunkCount = 0;
+        _writer.alloc(PackedNumbers::chunkSize(packed.chunkCapacity));
+      }
+      packed.chunkCount++;
+      packed.count++;
+      return PACKED;
+    }
+  }
+
+  // JsonArray::unpack()
+  for (; packed.count > 0; packed.count--) {
+    _writer.alloc(sizeof(JsonArray::node_type));
+    nodes++;
+  }
+  if (length == 0) return NOT_A_NUMBER;
+  JsonVariant value;
+  return parseTokenTo(token, length, &value) ? NOT_PACKED : PACKING_FAILED;
+}
+#endif
+
+#if ARDUINOJSON_REUSE_SIBLING_KEYS
+// Finds the next key of the previous object, as the parser stored it
+template <typename TReader, typename TWriter>
+inline bool
+ArduinoJson::Internals::JsonParser<TReader, TWriter>::nextSiblingKey(
+    SiblingKeys &keys, TReader &key) {
+  while (nextKey(keys.next, key)) {
+    size_t index = keys.index++;
+#if ARDUINOJSON_REMOVE_DUPLICATE_KEYS
+    // removeDuplicateKeys() only kept the first one
+    if (keys.hasDuplicates && isDuplicateKey(keys.object, key, index))
+      continue;
+#else
+    (void)index;
+#endif
+    return true;
+  }
+  return false;
+}
+
+// Finds the next key of an object that was already validated.
+// The cursor starts at the '{', and stops after the value of the key.
+template <typename TReader, typename TWriter>
+inline bool ArduinoJson::Internals::JsonParser<TReader, TWriter>::nextKey(
+    TReader &cursor, TReader &key) {
+  if (!eat(cursor, '{') && !eat(cursor, ',')) return false;
+  skipSpacesAndComments(cursor);
+  if (cursor.current() == '}') return false;
+  key = cursor;
+  StringWindow<0> ignored;
+  readString(cursor, ignored);
+  eat(cursor, ':');
+  skipValue(cursor);
+  return true;
+}
+
+// Skips a value that was already validated
+template <typename TReader, typename TWriter>
+inline void ArduinoJson::Internals::JsonParser<TReader, TWriter>::skipValue(
+    TReader &reader) {
+  skipSpacesAndComments(reader);
+  char c = reader.current();
+  if (c != '[' && c != '{') {
+    StringWindow<0> ignored;
+    readString(reader, ignored);
+    return;
+  }
+
+  reader.move();
+  for (;;) {
+    skipSpacesAndComments(reader);
+    c = reader.current();
+    if (c == ']' || c == '}') {
+      reader.move();
+      return;
+    }
+    if (c == '\0') return;
+    if (c == ',' || c == ':')
+      reader.move();
+    else
+      skipValue(reader);  // a value or a key
+  }
+}
+
+#if ARDUINOJSON_REMOVE_DUPLICATE_KEYS
+// Tells whether an object that was already validated has duplicate keys.
+// The keys are hashed in a bit field first, so that only the keys that
+// share a bit are compared.
+template <typename TReader, typename TWriter>
+inline bool
+ArduinoJson::Internals::JsonParser<TReader, TWriter>::hasDuplicateKeys(
+    const TReader &object) {
+  const size_t bits = 1024;
+  uint8_t seen[bits / 8] = {0};
+  TReader cursor = object;
+  TReader key = object;
+  for (size_t index = 0; nextKey(cursor, key); index++) {
+    TReader reader = key;
+    StringHasher hasher;
+    readString(reader, hasher);
+    size_t bit = hasher.value() % bits;
+    uint8_t mask = static_cast<uint8_t>(1 << (bit % 8));
+    if (!(seen[bit / 8] & mask))
+      seen[bit / 8] |= mask;
+    else if (isDuplicateKey(object, key, index))
+      return true;
+  }
+  return false;
+}
+
+// Tells whether one of the first keys of an object has the same value
+template <typename TReader, typename TWriter>
+inline bool
+ArduinoJson::Internals::JsonParser<TReader, TWriter>::isDuplicateKey(
+    const TReader &object, const TReader &key, size_t index) {
+  TReader cursor = object;
+  TReader other = object;
+  for (size_t i = 0; i < index && nextKey(cursor, other); i++)
+    if (sameKey(other, key)) return true;
+  return false;
+}
+
+// Compares two keys of the input, as the parser would decode them
+template <typename TReader, typename TWriter>
+inline bool ArduinoJson::Internals::JsonParser<TReader, TWriter>::sameKey(
+    const TReader &a, const TReader &b) {
+  const size_t windowSize = 64;
+  for (size_t position = 0;; position += windowSize) {
+    TReader readerA = a;
+    TReader readerB = b;
+    StringWindow<windowSize> windowA(position);
+    StringWindow<windowSize> windowB(position);
+    readString(readerA, windowA);
+    readString(readerB, windowB);
+    if (windowA.size() != windowB.size()) return false;
+    if (strcmp(windowA.c_str(), windowB.c_str()) != 0) return false;
+    if (position + windowSize >= windowA.size()) return true;
+  }
+}
+#endif
+#endif
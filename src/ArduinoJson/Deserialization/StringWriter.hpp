@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <string.h>  // memmove
+
 namespace ArduinoJson {
 namespace Internals {
 
@@ -18,6 +20,12 @@ class StringWriter {
       *(*_writePtr)++ = TChar(c);
     }
 
+    // The characters may overlap, as the input is rewritten in place
+    void append(const char* chars, size_t length) {
+      memmove(*_writePtr, chars, length);
+      *_writePtr += length;
+    }
+
     const char* c_str() const {
       *(*_writePtr)++ = 0;
       return reinterpret_cast<const char*>(_startPtr);
@@ -0,0 +1,38 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#pragma once
+
+#include <string.h>  // for strcmp
+
+#include "../Data/PackedNumbers.hpp"
+#include "../JsonVariant.hpp"
+
+namespace ArduinoJson {
+namespace Internals {
+
+// Converts an unquoted value of the input: true, false, null or a number
+// (see ARDUINOJSON_DECODE_LITERALS).
+// Returns false if the value must stay a RawJson: an unquoted string, or an
+// integer that doesn't fit in a JsonInteger.
+inline bool decodeLiteral(const char *token, JsonVariant *result) {
+  if (!strcmp(token, "true") || !strcmp(token, "false")) {
+    *result = token[0] == 't';
+    return true;
+  }
+  if (!strcmp(token, "null")) {
+    *result = static_cast<const char *>(NULL);
+    return true;
+  }
+  PackedNumbers::Value number;
+  bool isFloat;
+  if (!PackedNumbers::parse(token, number, isFloat)) return false;
+  if (isFloat)
+    *result = number.asFloat;
+  else
+    *result = number.asInteger;
+  return true;
+}
+}
+}
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include "Data/JsonBufferStats.hpp"
+#include "Data/JsonCloner.hpp"
 #include "JsonBufferBase.hpp"
 
 #include <stdlib.h>
@@ -32,7 +34,8 @@ class DefaultAllocator {
 
 template <typename TAllocator>
 class DynamicJsonBufferBase
-    : public JsonBufferBase<DynamicJsonBufferBase<TAllocator> > {
+    : public JsonBufferBase<DynamicJsonBufferBase<TAllocator> >,
+      private JsonBufferStatsRecorder {
   struct Block;
   struct EmptyBlock {
     Block* next;
@@ -46,11 +49,30 @@ class DynamicJsonBufferBase
  public:
   enum { EmptyBlockSize = sizeof(EmptyBlock) };
 
-  DynamicJsonBufferBase(size_t initialSize = 256)
-      : _head(NULL), _nextBlockCapacity(initialSize) {}
+  // Controls how the buffer grows when a block is full
+  struct GrowthPolicy {
+    GrowthPolicy()
+        : factor(2), maxBlockCapacity(0), directAllocationThreshold(0) {}
+
+    // The capacity of each new block is multiplied by this factor
+    size_t factor;
+    // The capacity of new blocks stops growing at this value (0 = no limit)
+    size_t maxBlockCapacity;
+    // Allocations bigger than this value get a block of their own, which
+    // doesn't affect the capacity of the following blocks (0 = never)
+    size_t directAllocationThreshold;
+  };
+
+  DynamicJsonBufferBase(size_t initialSize = 256,
+                        TAllocator allocator = TAllocator())
+      : _allocator(allocator),
+        _head(NULL),
+        _inline(NULL),
+        _initialBlockCapacity(initialSize),
+        _nextBlockCapacity(initialSize) {}
 
   ~DynamicJsonBufferBase() {
-    clear();
+    freeBlocks();
   }
 
   // Gets the number of bytes occupied in the buffer
@@ -60,23 +82,133 @@ class DynamicJsonBufferBase
     return total;
   }
 
+  const GrowthPolicy& growthPolicy() const {
+    return _growth;
+  }
+
+  void setGrowthPolicy(const GrowthPolicy& policy) {
+    _growth = policy;
+    _nextBlockCapacity = capBlockCapacity(_nextBlockCapacity);
+  }
+
+#if ARDUINOJSON_ENABLE_STATS
+  // Gets the statistics about the memory usage
+  JsonBufferStats stats() const {
+    size_t abandoned = 0;
+    for (const Block* b = _head ? _head->next : NULL; b; b = b->next)
+      abandoned += b->capacity - b->size;
+    return this->getStats(size(), abandoned);
+  }
+#endif
+
   // Allocates the specified amount of bytes in the buffer
   virtual void* alloc(size_t bytes) {
     alignNextAlloc();
-    return canAllocInHead(bytes) ? allocInHead(bytes) : allocInNewBlock(bytes);
+    void* p;
+    if (canAllocInHead(bytes))
+      p = allocInHead(bytes);
+    else if (isDirectAllocation(bytes))
+      p = allocInDirectBlock(bytes);
+    else
+      p = allocInNewBlock(bytes);
+    if (p) this->recordRequest(bytes);
+    return p;
   }
 
   // Resets the buffer.
   // USE WITH CAUTION: this invalidates all previously allocated data
   void clear() {
-    Block* currentBlock = _head;
-    while (currentBlock != NULL) {
-      _nextBlockCapacity = currentBlock->capacity;
-      Block* nextBlock = currentBlock->next;
-      _allocator.deallocate(currentBlock);
-      currentBlock = nextBlock;
+    this->recordClear(size());
+    freeBlocks();
+    _head = _inline;
+    if (_inline) {
+      _inline->next = NULL;
+      _inline->size = 0;
     }
-    _head = 0;
+    _nextBlockCapacity = capBlockCapacity(_initialBlockCapacity);
+  }
+
+  // Makes sure that the next allocations of the specified amount of bytes
+  // will be contiguous, in the current block or in a new one of this exact
+  // capacity.
+  // Returns false if the allocation of the new block fails.
+  bool reserve(size_t bytes) {
+    alignNextAlloc();
+    if (canAllocInHead(bytes)) return true;
+    return addNewBlock(bytes);
+  }
+
+  // Makes a deep copy of a JsonVariant in a block that fits it exactly.
+  // The values are allocated in depth-first order, so a long-lived document
+  // built piece by piece can be copied to a cache-friendly layout.
+  // Returns an undefined JsonVariant if the allocation fails.
+  JsonVariant compact(const JsonVariant& source) {
+    if (!reserve(Internals::JsonCloner::measure(source))) return JsonVariant();
+    return this->clone(source);
+  }
+
+  // Resets the buffer but keeps the memory for the next use.
+  // If the buffer spans several blocks, they are merged into a single block
+  // big enough to hold everything that was allocated, so that filling the
+  // buffer with a similar content doesn't need to call the allocator again.
+  // The merged block is limited to the maximum block capacity of the growth
+  // policy, so that one large document doesn't stick in memory forever.
+  // USE WITH CAUTION: this invalidates all previously allocated data
+  void recycle() {
+    if (_head == NULL) return;
+    if (_head->next != NULL) {
+      size_t capacity = 0;
+      for (const Block* b = _head; b; b = b->next)
+        capacity += this->round_size_up(b->size);
+      capacity = capBlockCapacity(capacity);
+      size_t nextBlockCapacity = _nextBlockCapacity;
+      clear();
+      _nextBlockCapacity = nextBlockCapacity;
+      if (!addNewBlock(capacity)) return;
+    } else {
+      this->recordClear(_head->size);
+    }
+    _head->size = 0;
+  }
+
+  // A position in the buffer, returned by mark()
+  struct Mark : Checkpoint {
+    Block* block;  // the head block
+    size_t size;   // the size of the head block
+    Block* next;   // the block behind the head
+  };
+
+  // Saves the current position, to go back to it with release()
+  Mark mark() const {
+    Mark m;
+    static_cast<Checkpoint&>(m) = this->checkpoint();
+    m.block = _head;
+    m.size = _head ? _head->size : 0;
+    m.next = _head ? _head->next : NULL;
+    return m;
+  }
+
+  // Frees everything that was allocated after the mark, including the blocks.
+  // The mark must have been taken after the last clear() or recycle().
+  // USE WITH CAUTION: this invalidates the data allocated after the mark
+  void release(const Mark& m) {
+    this->recordRelease(size(), m);
+    // the blocks allocated after the mark are in front of it
+    while (_head != m.block && _head != m.next) {
+      Block* next = _head->next;
+      freeBlock(_head);
+      _head = next;
+    }
+    // the marked block may have been empty and released
+    if (_head == NULL || _head != m.block) return;
+    // the direct blocks allocated after the mark are behind it
+    for (Block* b = _head->next; b != m.next;) {
+      Block* next = b->next;
+      freeBlock(b);
+      b = next;
+    }
+    _head->next = m.next;
+    _head->size = m.size;
   }
 
   class String {
@@ -90,15 +222,29 @@ class DynamicJsonBufferBase
         *end = c;
         if (_length == 0) _start = end;
       } else {
-        char* newStart =
-            static_cast<char*>(_parent->allocInNewBlock(_length + 1));
-        if (_start && newStart) memcpy(newStart, _start, _length);
+        char* newStart = _parent->moveStringToNewBlock(_start, _length);
         if (newStart) newStart[_length] = c;
         _start = newStart;
       }
+      if (_start) _parent->recordRequest(1);
       _length++;
     }
 
+    void append(const char* chars, size_t length) {
+      if (!length) return;
+      char* end;
+      if (_parent->canAllocInHead(length)) {
+        end = static_cast<char*>(_parent->allocInHead(length));
+        if (_length == 0) _start = end;
+      } else {
+        _start = _parent->moveStringToNewBlock(_start, _length, length);
+        end = _start ? _start + _length : NULL;
+      }
+      if (end) memcpy(end, chars, length);
+      if (_start) _parent->recordRequest(length);
+      _length += length;
+    }
+
     const char* c_str() {
       append(0);
       return _start;
@@ -114,9 +260,38 @@ class DynamicJsonBufferBase
     return String(this);
   }
 
+ protected:
+  // Uses the specified memory as the first block; it is never released.
+  // The memory must be aligned and hold EmptyBlockSize + inlineCapacity bytes.
+  DynamicJsonBufferBase(void* inlineBlock, size_t inlineCapacity,
+                        TAllocator allocator)
+      : _allocator(allocator),
+        _head(static_cast<Block*>(inlineBlock)),
+        _inline(_head),
+        _initialBlockCapacity(inlineCapacity),
+        _nextBlockCapacity(inlineCapacity) {
+    _inline->next = NULL;
+    _inline->capacity = inlineCapacity;
+    _inline->size = 0;
+    this->recordNewBlock(inlineCapacity);
+  }
+
  private:
+  // Releases all the blocks, except the inline one
+  void freeBlocks() {
+    Block* currentBlock = _head;
+    while (currentBlock != NULL) {
+      Block* nextBlock = currentBlock->next;
+      if (currentBlock != _inline) freeBlock(currentBlock);
+      currentBlock = nextBlock;
+    }
+  }
+
   void alignNextAlloc() {
-    if (_head) _head->size = this->round_size_up(_head->size);
+    if (!_head) return;
+    size_t alignedSize = this->round_size_up(_head->size);
+    this->recordPadding(alignedSize - _head->size);
+    _head->size = alignedSize;
   }
 
   bool canAllocInHead(size_t bytes) const {
@@ -129,14 +304,65 @@ class DynamicJsonBufferBase
     return p;
   }
 
-  void* allocInNewBlock(size_t bytes) {
+  void* allocInNewBlock(size_t bytes, size_t minCapacity = 0) {
     size_t capacity = _nextBlockCapacity;
     if (bytes > capacity) capacity = bytes;
+    if (minCapacity > capacity) capacity = minCapacity;
     if (!addNewBlock(capacity)) return NULL;
-    _nextBlockCapacity *= 2;
+    _nextBlockCapacity = capBlockCapacity(_nextBlockCapacity * _growth.factor);
+    return allocInHead(bytes);
+  }
+
+  bool isDirectAllocation(size_t bytes) const {
+    return _growth.directAllocationThreshold > 0 &&
+           bytes > _growth.directAllocationThreshold;
+  }
+
+  // Allocates a block that fits exactly and inserts it behind the head, so
+  // that the head keeps serving the small allocations.
+  void* allocInDirectBlock(size_t bytes) {
+    Block* head = _head;
+    if (!addNewBlock(bytes)) return NULL;
+    if (head) {
+      Block* block = _head;
+      _head = head;
+      block->next = head->next;
+      head->next = block;
+      block->size = bytes;
+      return block->data;
+    }
     return allocInHead(bytes);
   }
 
+  size_t capBlockCapacity(size_t capacity) const {
+    if (_growth.maxBlockCapacity > 0 && capacity > _growth.maxBlockCapacity)
+      return _growth.maxBlockCapacity;
+    return capacity;
+  }
+
+  // Moves the string being built at the end of the head block to a new block
+  // with room for the extra characters, and for the string to double.
+  // The bytes of the old copy are given back to the previous block, which is
+  // released if it becomes empty.
+  char* moveStringToNewBlock(char* start, size_t length, size_t extra = 1) {
+    Block* previous = _head;
+    if (start) previous->size -= length;
+    char* newStart = static_cast<char*>(
+        allocInNewBlock(length + extra, 2 * (length + extra)));
+    if (!newStart) return NULL;
+    if (start) memcpy(newStart, start, length);
+    if (previous && previous->size == 0 && previous != _inline) {
+      _head->next = previous->next;
+      freeBlock(previous);
+    }
+    return newStart;
+  }
+
+  void freeBlock(Block* block) {
+    _allocator.deallocate(block);
+    this->recordFreeBlock();
+  }
+
   bool addNewBlock(size_t capacity) {
     size_t bytes = EmptyBlockSize + capacity;
     Block* block = static_cast<Block*>(_allocator.allocate(bytes));
@@ -145,12 +371,16 @@ class DynamicJsonBufferBase
     block->size = 0;
     block->next = _head;
     _head = block;
+    this->recordNewBlock(capacity);
     return true;
   }
 
   TAllocator _allocator;
   Block* _head;
+  Block* _inline;
+  size_t _initialBlockCapacity;
   size_t _nextBlockCapacity;
+  GrowthPolicy _growth;
 };
 }
 
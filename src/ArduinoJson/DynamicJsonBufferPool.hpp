@@ -0,0 +1,180 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#pragma once
+
+#include "Data/Lock.hpp"
+#include "Data/NonCopyable.hpp"
+#include "DynamicJsonBuffer.hpp"
+
+namespace ArduinoJson {
+namespace Internals {
+
+// A pool of DynamicJsonBuffers that keep their memory between two uses.
+//
+// A buffer is borrowed with a Lease and goes back to the pool, recycled, when
+// the Lease is destroyed. The pool keeps at most `capacity` idle buffers;
+// extra buffers are given to the overflow pool, if any, or destroyed.
+//
+// The pool is protected by TMutex, which does nothing by default. The
+// recommended setup is one pool per thread (a thread_local variable for
+// example) with a shared overflow pool protected by a std::mutex.
+// Each buffer keeps the allocator that created it, so the pools can have
+// different allocators.
+template <typename TAllocator, typename TMutex = NoMutex>
+class DynamicJsonBufferPoolBase : NonCopyable {
+  struct Node {
+    Node(size_t initialSize, const TAllocator &nodeAllocator)
+        : next(NULL),
+          allocator(nodeAllocator),
+          buffer(initialSize, nodeAllocator) {}
+
+    void *operator new(size_t, void *p) throw() {
+      return p;
+    }
+    void operator delete(void *, void *)throw() {}
+
+    Node *next;
+    TAllocator allocator;  // the one that allocated the node
+    DynamicJsonBufferBase<TAllocator> buffer;
+  };
+
+ public:
+  typedef DynamicJsonBufferBase<TAllocator> buffer_type;
+
+  // Borrows a buffer from the pool and returns it when destroyed
+  class Lease : NonCopyable {
+   public:
+    explicit Lease(DynamicJsonBufferPoolBase &pool)
+        : _pool(pool), _node(pool.take()) {
+#if ARDUINOJSON_ENABLE_KEY_TABLE
+      if (_node) _node->buffer.setKeyTable(pool._keyTable);
+#endif
+    }
+
+    ~Lease() {
+      _pool.give(_node);
+    }
+
+    // Returns false if the buffer couldn't be allocated
+    bool success() const {
+      return _node != NULL;
+    }
+
+    buffer_type &operator*() const {
+      return _node->buffer;
+    }
+    buffer_type *operator->() const {
+      return &_node->buffer;
+    }
+
+   private:
+    DynamicJsonBufferPoolBase &_pool;
+    Node *_node;
+  };
+  friend class Lease;
+
+  // Creates a pool that keeps up to `capacity` idle buffers.
+  // New buffers are created with the specified initial size and allocator.
+  // Extra buffers are given to `overflow` if not NULL.
+  explicit DynamicJsonBufferPoolBase(
+      size_t capacity = 4, size_t initialBufferSize = 256,
+      DynamicJsonBufferPoolBase *overflow = NULL,
+      TAllocator allocator = TAllocator())
+      : _allocator(allocator),
+        _idle(NULL),
+        _idleCount(0),
+        _capacity(capacity),
+        _initialBufferSize(initialBufferSize),
+        _overflow(overflow)
+#if ARDUINOJSON_ENABLE_KEY_TABLE
+        ,
+        _keyTable(NULL)
+#endif
+  {
+  }
+
+  ~DynamicJsonBufferPoolBase() {
+    while (_idle) {
+      Node *node = _idle;
+      _idle = node->next;
+      destroy(node);
+    }
+  }
+
+  // Gets the number of idle buffers in the pool
+  size_t size() const {
+    return _idleCount;
+  }
+
+#if ARDUINOJSON_ENABLE_KEY_TABLE
+  // Gives the specified JsonKeyTable to the buffers leased from now on
+  void setKeyTable(KeyInterner *table) {
+    _keyTable = table;
+  }
+#endif
+
+ private:
+  Node *take() {
+    {
+      Lock<TMutex> lock(_mutex);
+      if (_idle) {
+        Node *node = _idle;
+        _idle = node->next;
+        _idleCount--;
+        return node;
+      }
+    }
+    Node *node = _overflow ? _overflow->take() : NULL;
+    return node ? node : create();
+  }
+
+  void give(Node *node) {
+    if (!node) return;
+    node->buffer.recycle();
+    {
+      Lock<TMutex> lock(_mutex);
+      if (_idleCount < _capacity) {
+        node->next = _idle;
+        _idle = node;
+        _idleCount++;
+        return;
+      }
+    }
+    if (_overflow)
+      _overflow->give(node);
+    else
+      destroy(node);
+  }
+
+  Node *create() {
+    void *p = _allocator.allocate(sizeof(Node));
+    if (!p) return NULL;
+    return new (p) Node(_initialBufferSize, _allocator);
+  }
+
+  // The node may come from another pool, so it's freed by its own allocator
+  static void destroy(Node *node) {
+    TAllocator allocator = node->allocator;
+    node->~Node();
+    allocator.deallocate(node);
+  }
+
+  TAllocator _allocator;
+  TMutex _mutex;
+  Node *_idle;
+  size_t _idleCount;
+  size_t _capacity;
+  size_t _initialBufferSize;
+  DynamicJsonBufferPoolBase *_overflow;
+#if ARDUINOJSON_ENABLE_KEY_TABLE
+  KeyInterner *_keyTable;
+#endif
+};
+}
+
+// A pool of DynamicJsonBuffer that keeps their memory between two uses.
+typedef Internals::DynamicJsonBufferPoolBase<Internals::DefaultAllocator>
+    DynamicJsonBufferPool;
+}
@@ -0,0 +1,48 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#pragma once
+
+#include "DynamicJsonBuffer.hpp"
+
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wnon-virtual-dtor"
+#elif defined(__GNUC__)
+#if __GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 6)
+#pragma GCC diagnostic push
+#endif
+#pragma GCC diagnostic ignored "-Wnon-virtual-dtor"
+#endif
+
+namespace ArduinoJson {
+
+// Implements a JsonBuffer that starts with an inline memory pool, like
+// StaticJsonBuffer, and allocates blocks on the heap, like DynamicJsonBuffer,
+// only when the inline pool is full.
+// The template paramenter CAPACITY specifies the capacity of the inline pool
+// in bytes; it's also the capacity of the first heap block.
+template <size_t CAPACITY, typename TAllocator = Internals::DefaultAllocator>
+class HybridJsonBuffer : public Internals::DynamicJsonBufferBase<TAllocator> {
+  typedef Internals::DynamicJsonBufferBase<TAllocator> base_type;
+
+ public:
+  explicit HybridJsonBuffer(TAllocator allocator = TAllocator())
+      : base_type(_inline.bytes, CAPACITY, allocator) {}
+
+ private:
+  union {
+    void* align;
+    char bytes[base_type::EmptyBlockSize + CAPACITY];
+  } _inline;
+};
+}
+
+#if defined(__clang__)
+#pragma clang diagnostic pop
+#elif defined(__GNUC__)
+#if __GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 6)
+#pragma GCC diagnostic pop
+#endif
+#endif
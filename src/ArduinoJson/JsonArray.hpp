@@ -4,8 +4,11 @@
 
 #pragma once
 
+#include "Data/JsonArrayConstIterator.hpp"
 #include "Data/JsonBufferAllocated.hpp"
 #include "Data/List.hpp"
+#include "Data/NodeIndex.hpp"
+#include "Data/PackedNumbers.hpp"
 #include "Data/ReferenceType.hpp"
 #include "Data/ValueSaver.hpp"
 #include "JsonVariant.hpp"
@@ -28,6 +31,8 @@ class JsonObject;
 class JsonBuffer;
 namespace Internals {
 class JsonArraySubscript;
+template <typename TReader, typename TWriter>
+class JsonParser;
 }
 
 // An array of JsonVariant.
@@ -42,11 +47,21 @@ class JsonArray : public Internals::JsonPrintable<JsonArray>,
                   public Internals::List<JsonVariant>,
                   public Internals::JsonBufferAllocated {
  public:
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+  typedef Internals::JsonArrayConstIterator const_iterator;
+#endif
+
   // Create an empty JsonArray attached to the specified JsonBuffer.
   // You should not call this constructor directly.
   // Instead, use JsonBuffer::createArray() or JsonBuffer::parseArray().
   explicit JsonArray(JsonBuffer *buffer) throw()
-      : Internals::List<JsonVariant>(buffer) {}
+      : Internals::List<JsonVariant>(buffer)
+#if ARDUINOJSON_ARRAY_INDEX_THRESHOLD
+        ,
+        _index(NULL)
+#endif
+  {
+  }
 
   // Gets the value at the specified index
   const Internals::JsonArraySubscript operator[](size_t index) const;
@@ -105,16 +120,34 @@ class JsonArray : public Internals::JsonPrintable<JsonArray>,
   }
 
   // Gets the value at the specified index.
+  // The non-const version indexes the large arrays first, so that the
+  // following reads run in constant time.
+  template <typename T>
+  typename Internals::JsonVariantAs<T>::type get(size_t index) {
+    indexFor(index);
+    return static_cast<const JsonArray *>(this)->get<T>(index);
+  }
   template <typename T>
   typename Internals::JsonVariantAs<T>::type get(size_t index) const {
-    const_iterator it = begin() += index;
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+    if (isPacked()) return _packed.get(index).as<T>();
+#endif
+    const_iterator it = iteratorAt(index);
     return it != end() ? it->as<T>() : Internals::JsonVariantDefault<T>::get();
   }
 
   // Check the type of the value at specified index.
   template <typename T>
+  bool is(size_t index) {
+    indexFor(index);
+    return static_cast<const JsonArray *>(this)->is<T>(index);
+  }
+  template <typename T>
   bool is(size_t index) const {
-    const_iterator it = begin() += index;
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+    if (isPacked()) return index < size() && _packed.get(index).is<T>();
+#endif
+    const_iterator it = iteratorAt(index);
     return it != end() ? it->is<T>() : false;
   }
 
@@ -128,9 +161,29 @@ class JsonArray : public Internals::JsonPrintable<JsonArray>,
 
   // Removes element at specified index.
   void remove(size_t index) {
-    remove(begin() += index);
+    remove(iteratorAt(index));
+  }
+
+  // Removes the element pointed by the iterator.
+  void remove(iterator it) {
+#if ARDUINOJSON_ARRAY_INDEX_THRESHOLD
+    if (_index && it != end()) _index->remove(&*it);
+#endif
+    Internals::List<JsonVariant>::remove(it);
   }
-  using Internals::List<JsonVariant>::remove;
+
+#if ARDUINOJSON_ARRAY_INDEX_THRESHOLD
+  // Indexes the elements, so that they are accessed in constant time, even
+  // through a const JsonArray. The index is allocated in the JsonBuffer; the
+  // non-const functions allocate it anyway for the large arrays.
+  // Returns false if the JsonBuffer is full.
+  bool buildIndex() {
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+    if (!unpack()) return false;
+#endif
+    return updateIndex();
+  }
+#endif
 
   // Returns a reference an invalid JsonArray.
   // This object is meant to replace a NULL pointer.
@@ -200,20 +253,177 @@ class JsonArray : public Internals::JsonPrintable<JsonArray>,
   }
 #endif
 
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+  // Gets the number of elements
+  size_t size() const {
+    return isPacked() ? _packed.size() : Internals::List<JsonVariant>::size();
+  }
+
+  // Gets an iterator to the first element.
+  // The non-const version converts the packed values to JsonVariants first;
+  // the const version reads them in place.
+  iterator begin() {
+    unpack();
+    return Internals::List<JsonVariant>::begin();
+  }
+  const_iterator begin() const {
+    if (isPacked()) return const_iterator(_packed);
+    return const_iterator(firstNode());
+  }
+
+  iterator end() {
+    return Internals::List<JsonVariant>::end();
+  }
+  const_iterator end() const {
+    return const_iterator();
+  }
+
+  // Tells whether the values are numbers stored contiguously.
+  // The parser packs the arrays that contain only numbers. The non-const
+  // functions that access the elements convert the values to JsonVariants;
+  // the packed values stay in the JsonBuffer. The const functions read the
+  // packed values in place.
+  bool isPacked() const {
+    return _packed.size() > 0;
+  }
+
+  // Gets a pointer to the packed values, from the specified index, without
+  // copying them.
+  // Returns the number of values that can be read from this pointer. Returns
+  // 0 if the array is not packed, if the index is out of range, or if T is
+  // not the type of the values: JsonFloat if the array contains a float,
+  // JsonInteger otherwise.
+  template <typename T>
+  size_t packedData(size_t index, const T *&data) const {
+    if (sizeof(T) != sizeof(Internals::PackedNumbers::Value)) return 0;
+    if (_packed.isFloat() ? !Internals::IsSame<T, Internals::JsonFloat>::value
+                          : !Internals::IsSame<T, Internals::JsonInteger>::value)
+      return 0;
+    const Internals::PackedNumbers::Value *values;
+    size_t count = _packed.getContiguous(index, values);
+    if (count) data = reinterpret_cast<const T *>(values);
+    return count;
+  }
+#endif
+
  private:
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+  template <typename TReader, typename TWriter>
+  friend class Internals::JsonParser;
+  friend class Internals::JsonCloner;
+
+  // Converts the packed values to JsonVariants.
+  // Returns false if the JsonBuffer is full; the array then stays packed,
+  // with all its values.
+  bool unpack() {
+    if (!isPacked()) return true;
+    for (const_iterator it(_packed); it != end(); ++it) {
+      iterator node = Internals::List<JsonVariant>::add();
+      if (node == end()) {
+        while (Internals::List<JsonVariant>::size()) removeNext(NULL);
+        return false;
+      }
+      *node = *it;
+    }
+    _packed.clear();
+    return true;
+  }
+
+#endif
+
+#if ARDUINOJSON_ARRAY_INDEX_THRESHOLD
+  // Makes sure that the index covers all the elements.
+  // It's allocated in the JsonBuffer the first time an element is accessed
+  // by its index beyond ARDUINOJSON_ARRAY_INDEX_THRESHOLD, through a non-const
+  // function, and it's completed when it's used again.
+  // Returns false if the allocation of the index fails.
+  bool updateIndex() {
+    if (!_index) {
+      _index = Internals::NodeIndex::create(_buffer, size() > 4 ? size() : 4);
+      if (!_index) return false;
+    }
+    size_t count = _index->size();
+    node_type *node = count ? _index->find(count - 1)->next() : firstNode();
+    for (; node; node = node->next())
+      if (!_index->add(_buffer, node)) return false;
+    return true;
+  }
+#endif
+
+  // Finds the node at the specified index, or returns NULL.
+  // The const version uses the index but never allocates it, so that a
+  // document can be read from several threads.
+  // A packed array has no node.
+  node_type *findNode(size_t index) const {
+    if (index >= Internals::List<JsonVariant>::size()) return NULL;
+    node_type *node = firstNode();
+#if ARDUINOJSON_ARRAY_INDEX_THRESHOLD
+    if (_index) {
+      size_t count = _index->size();
+      if (index < count) return _index->find(index);
+      if (count) {
+        node = _index->find(count - 1)->next();
+        index -= count;
+      }
+    }
+#endif
+    while (index--) node = node->next();
+    return node;
+  }
+  node_type *findNode(size_t index) {
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+    unpack();
+#endif
+    indexFor(index);
+    return static_cast<const JsonArray *>(this)->findNode(index);
+  }
+
+  // Completes the index before an access beyond
+  // ARDUINOJSON_ARRAY_INDEX_THRESHOLD.
+  // The packed values need no index.
+  void indexFor(size_t index) {
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+    if (isPacked()) return;
+#endif
+#if ARDUINOJSON_ARRAY_INDEX_THRESHOLD
+    if (index >= ARDUINOJSON_ARRAY_INDEX_THRESHOLD && index < size())
+      updateIndex();
+#else
+    (void)index;
+#endif
+  }
+
+  iterator iteratorAt(size_t index) {
+    return iterator(findNode(index));
+  }
+
+  const_iterator iteratorAt(size_t index) const {
+    return const_iterator(findNode(index));
+  }
+
   template <typename TValueRef>
   bool set_impl(size_t index, TValueRef value) {
-    iterator it = begin() += index;
+    iterator it = iteratorAt(index);
     if (it == end()) return false;
     return Internals::ValueSaver<TValueRef>::save(_buffer, *it, value);
   }
 
   template <typename TValueRef>
   bool add_impl(TValueRef value) {
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+    if (!unpack()) return false;
+#endif
     iterator it = Internals::List<JsonVariant>::add();
     if (it == end()) return false;
     return Internals::ValueSaver<TValueRef>::save(_buffer, *it, value);
   }
+
+#if ARDUINOJSON_ARRAY_INDEX_THRESHOLD
+  Internals::NodeIndex *_index;
+#endif
+#if ARDUINOJSON_ENABLE_PACKED_ARRAYS
+  Internals::PackedNumbers _packed;
+#endif
 };
 
 namespace Internals {
@@ -17,7 +17,11 @@ namespace Internals {
 class JsonArraySubscript : public JsonVariantBase<JsonArraySubscript> {
  public:
   FORCE_INLINE JsonArraySubscript(JsonArray& array, size_t index)
-      : _array(array), _index(index) {}
+      : _array(array), _index(index), _readOnly(false) {}
+
+  // The reads of a const JsonArray never build its index
+  FORCE_INLINE JsonArraySubscript(const JsonArray& array, size_t index)
+      : _array(const_cast<JsonArray&>(array)), _index(index), _readOnly(true) {}
 
   FORCE_INLINE JsonArraySubscript& operator=(const JsonArraySubscript& src) {
     _array.set(_index, src);
@@ -49,11 +53,13 @@ class JsonArraySubscript : public JsonVariantBase<JsonArraySubscript> {
 
   template <typename T>
   FORCE_INLINE typename JsonVariantAs<T>::type as() const {
+    if (_readOnly) return static_cast<const JsonArray&>(_array).get<T>(_index);
     return _array.get<T>(_index);
   }
 
   template <typename T>
   FORCE_INLINE bool is() const {
+    if (_readOnly) return static_cast<const JsonArray&>(_array).is<T>(_index);
     return _array.is<T>(_index);
   }
 
@@ -85,6 +91,7 @@ class JsonArraySubscript : public JsonVariantBase<JsonArraySubscript> {
  private:
   JsonArray& _array;
   const size_t _index;
+  const bool _readOnly;
 };
 
 template <typename TImpl>
@@ -113,7 +120,7 @@ inline Internals::JsonArraySubscript JsonArray::operator[](size_t index) {
 
 inline const Internals::JsonArraySubscript JsonArray::operator[](
     size_t index) const {
-  return Internals::JsonArraySubscript(*const_cast<JsonArray*>(this), index);
+  return Internals::JsonArraySubscript(*this, index);
 }
 }
 
@@ -8,6 +8,7 @@
 #include <stdint.h>  // for uint8_t
 #include <string.h>
 
+#include "Data/KeyInterner.hpp"
 #include "Data/NonCopyable.hpp"
 #include "JsonVariant.hpp"
 #include "TypeTraits/EnableIf.hpp"
@@ -17,6 +18,18 @@ namespace ArduinoJson {
 class JsonArray;
 class JsonObject;
 
+namespace Internals {
+// Preserve aligment if necessary
+inline size_t round_size_up(size_t bytes) {
+#if ARDUINOJSON_ENABLE_ALIGNMENT
+  const size_t x = sizeof(void *) - 1;
+  return (bytes + x) & ~x;
+#else
+  return bytes;
+#endif
+}
+}
+
 // Entry point for using the library.
 //
 // Handle the memory management (done in derived classes) and calls the parser.
@@ -36,6 +49,13 @@ class JsonBuffer : Internals::NonCopyable {
   // allocation fails.
   JsonObject &createObject();
 
+  // Makes a deep copy of a JsonVariant, strings included.
+  // The values are allocated in depth-first order, each key and value right
+  // after its node.
+  //
+  // Returns an undefined JsonVariant if the allocation fails.
+  JsonVariant clone(const JsonVariant &source);
+
   // Duplicates a string
   //
   // const char* strdup(TValue);
@@ -59,7 +79,24 @@ class JsonBuffer : Internals::NonCopyable {
   // Return a pointer to the allocated memory or NULL if allocation fails.
   virtual void *alloc(size_t size) = 0;
 
+#if ARDUINOJSON_ENABLE_KEY_TABLE
+  // Makes the parser take the keys from the specified JsonKeyTable instead of
+  // copying them in this JsonBuffer. NULL restores the default behavior.
+  // The table must outlive the objects.
+  void setKeyTable(Internals::KeyInterner *table) {
+    _keyTable = table;
+  }
+
+  Internals::KeyInterner *keyTable() const {
+    return _keyTable;
+  }
+#endif
+
  protected:
+#if ARDUINOJSON_ENABLE_KEY_TABLE
+  JsonBuffer() : _keyTable(NULL) {}
+#endif
+
   // CAUTION: NO VIRTUAL DESTRUCTOR!
   // If we add a virtual constructor the Arduino compiler will add malloc()
   // and free() to the binary, adding 706 useless bytes.
@@ -67,12 +104,12 @@ class JsonBuffer : Internals::NonCopyable {
 
   // Preserve aligment if necessary
   static FORCE_INLINE size_t round_size_up(size_t bytes) {
-#if ARDUINOJSON_ENABLE_ALIGNMENT
-    const size_t x = sizeof(void *) - 1;
-    return (bytes + x) & ~x;
-#else
-    return bytes;
-#endif
+    return Internals::round_size_up(bytes);
   }
+
+#if ARDUINOJSON_ENABLE_KEY_TABLE
+ private:
+  Internals::KeyInterner *_keyTable;
+#endif
 };
 }
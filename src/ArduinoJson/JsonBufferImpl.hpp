@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "Data/JsonCloner.hpp"
 #include "Deserialization/JsonParser.hpp"
 
 inline ArduinoJson::JsonArray &ArduinoJson::JsonBuffer::createArray() {
@@ -15,3 +16,10 @@ inline ArduinoJson::JsonObject &ArduinoJson::JsonBuffer::createObject() {
   JsonObject *ptr = new (this) JsonObject(this);
   return ptr ? *ptr : JsonObject::invalid();
 }
+
+inline ArduinoJson::JsonVariant ArduinoJson::JsonBuffer::clone(
+    const JsonVariant &source) {
+  JsonVariant result;
+  if (!Internals::JsonCloner::clone(result, source, this)) return JsonVariant();
+  return result;
+}
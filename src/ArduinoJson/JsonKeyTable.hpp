@@ -0,0 +1,149 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#pragma once
+
+#include <string.h>  // for memcpy, strncmp
+
+#include "Data/KeyInterner.hpp"
+#include "Data/Lock.hpp"
+#include "Data/NonCopyable.hpp"
+#include "DynamicJsonBuffer.hpp"
+#include "Polyfills/hash.hpp"
+
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wnon-virtual-dtor"
+#elif defined(__GNUC__)
+#if __GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 6)
+#pragma GCC diagnostic push
+#endif
+#pragma GCC diagnostic ignored "-Wnon-virtual-dtor"
+#endif
+
+namespace ArduinoJson {
+namespace Internals {
+
+// A table of keys shared by several JsonBuffers.
+//
+// When a JsonBuffer has a key table (see JsonBuffer::setKeyTable()), the
+// parser stores each key once in the table, instead of copying it in every
+// document, and all the objects use the same address for the same key.
+// The keys stay in the table until it's destroyed, so the table must outlive
+// the JsonBuffers. It holds at most `maxKeys` keys of up to 64 characters;
+// the others are copied in the JsonBuffer as usual.
+//
+// To share the table between threads, use a real mutex (like std::mutex) for
+// TMutex.
+template <typename TAllocator = DefaultAllocator, typename TMutex = NoMutex>
+class JsonKeyTableBase : public KeyInterner, NonCopyable {
+  struct Slot {
+    char *key;
+    uint32_t hash;
+  };
+
+ public:
+  explicit JsonKeyTableBase(size_t maxKeys = 1024,
+                            TAllocator allocator = TAllocator())
+      : _allocator(allocator),
+        _slots(NULL),
+        _capacity(0),
+        _size(0),
+        _maxKeys(maxKeys) {}
+
+  ~JsonKeyTableBase() {
+    for (size_t i = 0; i < _capacity; i++)
+      if (_slots[i].key) _allocator.deallocate(_slots[i].key);
+    _allocator.deallocate(_slots);
+  }
+
+  // Gets the number of keys in the table
+  size_t size() const {
+    return _size;
+  }
+
+  // Returns the canonical copy of the string, adding it if needed.
+  // Returns NULL if the table is full or the allocation fails.
+  virtual const char *intern(const char *chars, size_t length) {
+    StringHasher hasher;
+    for (size_t i = 0; i < length; i++) hasher.append(chars[i]);
+    uint32_t hash = hasher.value();
+
+    Lock<TMutex> lock(_mutex);
+    Slot *slot = find(chars, length, hash);
+    if (slot && slot->key) return slot->key;
+    if (_size >= _maxKeys) return NULL;
+    if (2 * (_size + 1) > _capacity) {
+      if (!grow()) return NULL;
+      slot = find(chars, length, hash);
+    }
+    char *key = static_cast<char *>(_allocator.allocate(length + 1));
+    if (!key) return NULL;
+    memcpy(key, chars, length);
+    key[length] = 0;
+    slot->key = key;
+    slot->hash = hash;
+    _size++;
+    return key;
+  }
+  //
+  // const char* intern(const char*);
+  const char *intern(const char *key) {
+    return intern(key, strlen(key));
+  }
+
+ private:
+  // Returns the slot of the key, or the empty slot where it should go
+  Slot *find(const char *chars, size_t length, uint32_t hash) const {
+    if (!_capacity) return NULL;
+    size_t mask = _capacity - 1;
+    for (size_t i = hash & mask;; i = (i + 1) & mask) {
+      Slot *slot = &_slots[i];
+      if (!slot->key) return slot;
+      // strncmp() stops at the end of a shorter stored key, memcmp() wouldn't
+      if (slot->hash == hash && !strncmp(slot->key, chars, length) &&
+          slot->key[length] == 0)
+        return slot;
+    }
+  }
+
+  bool grow() {
+    size_t capacity = _capacity ? 2 * _capacity : 16;
+    Slot *slots =
+        static_cast<Slot *>(_allocator.allocate(capacity * sizeof(Slot)));
+    if (!slots) return false;
+    for (size_t i = 0; i < capacity; i++) slots[i].key = NULL;
+    for (size_t i = 0; i < _capacity; i++) {
+      if (!_slots[i].key) continue;
+      size_t j = _slots[i].hash & (capacity - 1);
+      while (slots[j].key) j = (j + 1) & (capacity - 1);
+      slots[j] = _slots[i];
+    }
+    _allocator.deallocate(_slots);
+    _slots = slots;
+    _capacity = capacity;
+    return true;
+  }
+
+  TAllocator _allocator;
+  TMutex _mutex;
+  Slot *_slots;
+  size_t _capacity;  // a power of two
+  size_t _size;
+  size_t _maxKeys;
+};
+}
+
+// A table of keys shared by several JsonBuffers, see JsonKeyTableBase.
+typedef Internals::JsonKeyTableBase<Internals::DefaultAllocator>
+    JsonKeyTable;
+}
+
+#if defined(__clang__)
+#pragma clang diagnostic pop
+#elif defined(__GNUC__)
+#if __GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 6)
+#pragma GCC diagnostic pop
+#endif
+#endif
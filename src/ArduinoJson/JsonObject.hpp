@@ -5,6 +5,7 @@
 #pragma once
 
 #include "Data/JsonBufferAllocated.hpp"
+#include "Data/KeyIndex.hpp"
 #include "Data/List.hpp"
 #include "Data/ReferenceType.hpp"
 #include "Data/ValueSaver.hpp"
@@ -29,6 +30,8 @@ class JsonBuffer;
 namespace Internals {
 template <typename>
 class JsonObjectSubscript;
+template <typename TReader, typename TWriter>
+class JsonParser;
 }
 
 // A dictionary of JsonVariant indexed by string (char*)
@@ -47,7 +50,17 @@ class JsonObject : public Internals::JsonPrintable<JsonObject>,
   // You should not use this constructor directly.
   // Instead, use JsonBuffer::createObject() or JsonBuffer.parseObject().
   explicit JsonObject(JsonBuffer* buffer) throw()
-      : Internals::List<JsonPair>(buffer) {}
+      : Internals::List<JsonPair>(buffer)
+#if ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+        ,
+        _index(NULL)
+#endif
+#if ARDUINOJSON_ENABLE_KEY_HASH
+        ,
+        _staleKeyHashes(false)
+#endif
+  {
+  }
 
   // Gets or sets the value associated with the specified key.
   //
@@ -73,8 +86,7 @@ class JsonObject : public Internals::JsonPrintable<JsonObject>,
   template <typename TString>
   const Internals::JsonObjectSubscript<const TString&> operator[](
       const TString& key) const {
-    return Internals::JsonObjectSubscript<const TString&>(
-        *const_cast<JsonObject*>(this), key);
+    return Internals::JsonObjectSubscript<const TString&>(*this, key);
   }
   //
   // const JsonObjectSubscript operator[](TKey) const;
@@ -82,8 +94,7 @@ class JsonObject : public Internals::JsonPrintable<JsonObject>,
   template <typename TString>
   const Internals::JsonObjectSubscript<TString*> operator[](
       TString* key) const {
-    return Internals::JsonObjectSubscript<TString*>(
-        *const_cast<JsonObject*>(this), key);
+    return Internals::JsonObjectSubscript<TString*>(*this, key);
   }
 
   // Sets the specified key with the specified value.
@@ -146,6 +157,8 @@ class JsonObject : public Internals::JsonPrintable<JsonObject>,
   }
 
   // Gets the value associated with the specified key.
+  // The non-const version indexes the large objects first, so that the
+  // following searches run in constant time.
   //
   // TValue get<TValue>(TKey) const;
   // TKey = const std::string&, const String&
@@ -156,6 +169,11 @@ class JsonObject : public Internals::JsonPrintable<JsonObject>,
       const TString& key) const {
     return get_impl<const TString&, TValue>(key);
   }
+  template <typename TValue, typename TString>
+  typename Internals::JsonVariantAs<TValue>::type get(const TString& key) {
+    indexKeys();
+    return get_impl<const TString&, TValue>(key);
+  }
   //
   // TValue get<TValue>(TKey) const;
   // TKey = char*, const char*, const FlashStringHelper*
@@ -165,6 +183,11 @@ class JsonObject : public Internals::JsonPrintable<JsonObject>,
   typename Internals::JsonVariantAs<TValue>::type get(TString* key) const {
     return get_impl<TString*, TValue>(key);
   }
+  template <typename TValue, typename TString>
+  typename Internals::JsonVariantAs<TValue>::type get(TString* key) {
+    indexKeys();
+    return get_impl<TString*, TValue>(key);
+  }
 
   // Checks the type of the value associated with the specified key.
   //
@@ -177,6 +200,11 @@ class JsonObject : public Internals::JsonPrintable<JsonObject>,
   bool is(const TString& key) const {
     return is_impl<const TString&, TValue>(key);
   }
+  template <typename TValue, typename TString>
+  bool is(const TString& key) {
+    indexKeys();
+    return is_impl<const TString&, TValue>(key);
+  }
   //
   // bool is<TValue>(TKey) const;
   // TKey = char*, const char*, const FlashStringHelper*
@@ -186,6 +214,11 @@ class JsonObject : public Internals::JsonPrintable<JsonObject>,
   bool is(TString* key) const {
     return is_impl<TString*, TValue>(key);
   }
+  template <typename TValue, typename TString>
+  bool is(TString* key) {
+    indexKeys();
+    return is_impl<TString*, TValue>(key);
+  }
 
   // Creates and adds a JsonArray.
   //
@@ -226,6 +259,10 @@ class JsonObject : public Internals::JsonPrintable<JsonObject>,
   bool containsKey(const TString& key) const {
     return findKey<const TString&>(key) != end();
   }
+  template <typename TString>
+  bool containsKey(const TString& key) {
+    return findKey<const TString&>(key) != end();
+  }
   //
   // bool containsKey(TKey);
   // TKey = char*, const char*, char[], const char[], const FlashStringHelper*
@@ -233,6 +270,10 @@ class JsonObject : public Internals::JsonPrintable<JsonObject>,
   bool containsKey(TString* key) const {
     return findKey<TString*>(key) != end();
   }
+  template <typename TString>
+  bool containsKey(TString* key) {
+    return findKey<TString*>(key) != end();
+  }
 
   // Removes the specified key and the associated value.
   //
@@ -251,7 +292,81 @@ class JsonObject : public Internals::JsonPrintable<JsonObject>,
   }
   //
   // void remove(iterator)
-  using Internals::List<JsonPair>::remove;
+
+#if ARDUINOJSON_OBJECT_INDEX_THRESHOLD || ARDUINOJSON_ENABLE_KEY_HASH
+  // Gets an iterator to the first pair.
+  // The keys can be changed through this iterator, so the hashes and the hash
+  // table will be computed again by the next non-const search; until then,
+  // the const searches compare the strings.
+  iterator begin() {
+#if ARDUINOJSON_ENABLE_KEY_HASH
+    _staleKeyHashes = true;
+#endif
+#if ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+    if (_index) _index->last = NULL;
+#endif
+    return Internals::List<JsonPair>::begin();
+  }
+  const_iterator begin() const {
+    return Internals::List<JsonPair>::begin();
+  }
+#endif
+
+  // Removes the duplicate keys.
+  // Each key stays at the position of its first occurrence, with the value of
+  // its last occurrence, as if the pairs were inserted with set().
+  // An object with ARDUINOJSON_OBJECT_INDEX_THRESHOLD keys or more is merged
+  // in one pass: the hash table is filled as the pairs are visited, so each
+  // key is searched in constant time. It's the table that the first
+  // non-const search would build anyway.
+  void removeDuplicateKeys() {
+    refreshKeyHashes();
+#if ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+    bool indexing =
+        size() >= ARDUINOJSON_OBJECT_INDEX_THRESHOLD && clearIndex();
+#endif
+    node_type* previous = NULL;
+    node_type* node = firstNode();
+    while (node) {
+      node_type* next = node->next();
+      // the table holds the previous nodes, so it's either one of them or
+      // this one
+      node_type* first = findNode<const char*>(node->content().key);
+      if (first != node) {
+        first->content().value = node->content().value;
+#if ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+        if (!indexing && _index && _index->last) unindex(&node->content());
+#endif
+        removeNext(previous);
+      } else {
+#if ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+        if (indexing) indexing = _index->insert(_buffer, node);
+#endif
+        previous = node;
+      }
+      node = next;
+    }
+  }
+
+  // Removes the pair pointed by the iterator.
+  void remove(iterator it) {
+#if ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+    if (_index && _index->last && it != end()) unindex(&*it);
+#endif
+    Internals::List<JsonPair>::remove(it);
+  }
+
+#if ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+  // Indexes the keys in a hash table, so that they are searched in constant
+  // time, even through a const JsonObject. The table is allocated in the
+  // JsonBuffer; the non-const functions allocate it anyway for the large
+  // objects.
+  // Returns false if the JsonBuffer is full.
+  bool buildIndex() {
+    refreshKeyHashes();
+    return updateIndex();
+  }
+#endif
 
   // Returns a reference an invalid JsonObject.
   // This object is meant to replace a NULL pointer.
@@ -262,18 +377,60 @@ class JsonObject : public Internals::JsonPrintable<JsonObject>,
   }
 
  private:
+  template <typename TReader, typename TWriter>
+  friend class Internals::JsonParser;
+
+  // Adds a pair without looking for the key; used by the parser.
+  // The key must be stored in the JsonBuffer already.
+  bool append(const char* key, const JsonVariant& value) {
+    iterator it = Internals::List<JsonPair>::add();
+    if (it == end()) return false;
+    it->key = key;
+    it->value = value;
+    updateKeyHash(*it);
+    return true;
+  }
+
   // Returns the list node that matches the specified key.
+  // The non-const version completes the hash table of the large objects.
   template <typename TStringRef>
   iterator findKey(TStringRef key) {
-    iterator it;
-    for (it = begin(); it != end(); ++it) {
-      if (Internals::StringTraits<TStringRef>::equals(key, it->key)) break;
-    }
-    return it;
+    indexKeys();
+    return iterator(findNode<TStringRef>(key));
   }
   template <typename TStringRef>
   const_iterator findKey(TStringRef key) const {
-    return const_cast<JsonObject*>(this)->findKey<TStringRef>(key);
+    return const_iterator(findNode<TStringRef>(key));
+  }
+
+  // Searches the key in the hash table, if any, then in the following nodes.
+  // It never allocates, so that a document can be read from several threads.
+  template <typename TStringRef>
+  node_type* findNode(TStringRef key) const {
+    node_type* node = firstNode();
+#if ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+    if (_index && _index->last) {
+      node_type* found = _index->find<TStringRef>(key);
+      if (found) return found;
+      node = _index->last->next();
+    }
+#endif
+#if ARDUINOJSON_ENABLE_KEY_HASH
+    if (node && !_staleKeyHashes) {
+      uint32_t hash = Internals::StringTraits<TStringRef>::hash(key);
+      for (; node; node = node->next()) {
+        if (node->content().keyHash != hash) continue;
+        if (Internals::StringTraits<TStringRef>::equals(key, node->content().key))
+          break;
+      }
+      return node;
+    }
+#endif
+    for (; node; node = node->next()) {
+      if (Internals::StringTraits<TStringRef>::equals(key, node->content().key))
+        break;
+    }
+    return node;
   }
 
   template <typename TStringRef, typename TValue>
@@ -294,6 +451,7 @@ class JsonObject : public Internals::JsonPrintable<JsonObject>,
       bool key_ok =
           Internals::ValueSaver<TStringRef>::save(_buffer, it->key, key);
       if (!key_ok) return false;
+      updateKeyHash(*it);
     }
     return Internals::ValueSaver<TValueRef>::save(_buffer, it->value, value);
   }
@@ -307,8 +465,79 @@ class JsonObject : public Internals::JsonPrintable<JsonObject>,
   template <typename TStringRef>
   JsonArray& createNestedArray_impl(TStringRef key);
 
+  // Prepares the non-const searches: recomputes the stale hashes and completes
+  // the hash table of the objects with ARDUINOJSON_OBJECT_INDEX_THRESHOLD keys
+  // or more.
+  void indexKeys() {
+    refreshKeyHashes();
+#if ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+    if (size() >= ARDUINOJSON_OBJECT_INDEX_THRESHOLD) updateIndex();
+#endif
+  }
+
   template <typename TStringRef>
   JsonObject& createNestedObject_impl(TStringRef key);
+
+#if ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+  // Makes sure that the hash table contains all the keys.
+  // It's allocated in the JsonBuffer the first time a non-const function
+  // searches a key in an object with ARDUINOJSON_OBJECT_INDEX_THRESHOLD keys
+  // or more; a segment is appended when it gets half full.
+  // Returns false if an allocation fails; the keys that follow are then
+  // searched linearly.
+  bool updateIndex() {
+    if ((!_index || !_index->last) && !clearIndex()) return false;
+    node_type* node = _index->last ? _index->last->next() : firstNode();
+    for (; node; node = node->next())
+      if (!_index->insert(_buffer, node)) return false;
+    return true;
+  }
+
+  // Empties the hash table, or allocates it.
+  // Returns false if the allocation fails.
+  bool clearIndex() {
+    if (_index) {
+      _index->clear();
+      return true;
+    }
+    _index = Internals::KeyIndex::create(
+        _buffer, Internals::KeyIndex::capacityFor(size()));
+    return _index != NULL;
+  }
+
+  void unindex(const JsonPair* pair) {
+    node_type* node = _index->remove(pair);
+    if (!node || node != _index->last) return;
+    node_type* previous = NULL;
+    for (node_type* n = firstNode(); n != node; n = n->next()) previous = n;
+    _index->last = previous;
+  }
+
+  Internals::KeyIndex* _index;
+#endif
+
+  static void updateKeyHash(JsonPair& pair) {
+#if ARDUINOJSON_ENABLE_KEY_HASH
+    pair.keyHash = Internals::hashString(pair.key);
+#else
+    (void)pair;
+#endif
+  }
+
+  // Recomputes the hashes if the keys may have been changed through an
+  // iterator
+  void refreshKeyHashes() {
+#if ARDUINOJSON_ENABLE_KEY_HASH
+    if (!_staleKeyHashes) return;
+    for (node_type* node = firstNode(); node; node = node->next())
+      updateKeyHash(node->content());
+    _staleKeyHashes = false;
+#endif
+  }
+
+#if ARDUINOJSON_ENABLE_KEY_HASH
+  bool _staleKeyHashes;
+#endif
 };
 
 namespace Internals {
@@ -23,7 +23,11 @@ class JsonObjectSubscript
 
  public:
   FORCE_INLINE JsonObjectSubscript(JsonObject& object, TStringRef key)
-      : _object(object), _key(key) {}
+      : _object(object), _key(key), _readOnly(false) {}
+
+  // The reads of a const JsonObject never build its hash table
+  FORCE_INLINE JsonObjectSubscript(const JsonObject& object, TStringRef key)
+      : _object(const_cast<JsonObject&>(object)), _key(key), _readOnly(true) {}
 
   FORCE_INLINE this_type& operator=(const this_type& src) {
     _object.set(_key, src);
@@ -51,16 +55,19 @@ class JsonObjectSubscript
   }
 
   FORCE_INLINE bool success() const {
+    if (_readOnly) return readOnlyObject().containsKey(_key);
     return _object.containsKey(_key);
   }
 
   template <typename TValue>
   FORCE_INLINE typename JsonVariantAs<TValue>::type as() const {
+    if (_readOnly) return readOnlyObject().template get<TValue>(_key);
     return _object.get<TValue>(_key);
   }
 
   template <typename TValue>
   FORCE_INLINE bool is() const {
+    if (_readOnly) return readOnlyObject().template is<TValue>(_key);
     return _object.is<TValue>(_key);
   }
 
@@ -91,8 +98,13 @@ class JsonObjectSubscript
   }
 
  private:
+  const JsonObject& readOnlyObject() const {
+    return _object;
+  }
+
   JsonObject& _object;
   TStringRef _key;
+  const bool _readOnly;
 };
 
 #if ARDUINOJSON_ENABLE_STD_STREAM
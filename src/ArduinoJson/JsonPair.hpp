@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "Configuration.hpp"
 #include "JsonVariant.hpp"
 
 namespace ArduinoJson {
@@ -12,5 +13,9 @@ namespace ArduinoJson {
 struct JsonPair {
   const char* key;
   JsonVariant value;
+#if ARDUINOJSON_ENABLE_KEY_HASH
+  // The hash of the key, maintained by JsonObject
+  uint32_t keyHash;
+#endif
 };
 }
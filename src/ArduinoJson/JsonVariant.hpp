@@ -28,6 +28,11 @@ namespace ArduinoJson {
 // Forward declarations.
 class JsonArray;
 class JsonObject;
+namespace Internals {
+class JsonCloner;
+template <typename TReader, typename TWriter>
+class JsonParser;
+}
 
 // A variant that can be a any value serializable to a JSON value.
 //
@@ -39,10 +44,18 @@ class JsonObject;
 class JsonVariant : public Internals::JsonVariantBase<JsonVariant> {
   template <typename Print>
   friend class Internals::JsonSerializer;
+  friend class Internals::JsonCloner;
+#if ARDUINOJSON_ENABLE_INLINE_STRINGS
+  template <typename TReader, typename TWriter>
+  friend class Internals::JsonParser;
+#endif
 
  public:
-  // Creates an uninitialized JsonVariant
-  JsonVariant() : _type(Internals::JSON_UNDEFINED) {}
+  // Creates an undefined JsonVariant.
+  // The content is zeroed, so that copying it reads no uninitialized memory.
+  JsonVariant() : _type(Internals::JSON_UNDEFINED) {
+    _content.asInteger = 0;
+  }
 
   // Create a JsonVariant containing a boolean value.
   // It will be serialized as "true" or "false" in JSON.
@@ -90,7 +103,7 @@ class JsonVariant : public Internals::JsonVariantBase<JsonVariant> {
       _content.asInteger = static_cast<JsonUInt>(value);
     } else {
       _type = JSON_NEGATIVE_INTEGER;
-      _content.asInteger = static_cast<JsonUInt>(-value);
+      _content.asInteger = ~static_cast<JsonUInt>(value) + 1;
     }
   }
   // JsonVariant(unsigned short)
@@ -330,17 +343,37 @@ class JsonVariant : public Internals::JsonVariantBase<JsonVariant> {
   bool variantIsObject() const {
     return _type == Internals::JSON_OBJECT;
   }
+#if ARDUINOJSON_ENABLE_INLINE_STRINGS
+  // Copies a string shorter than InlineStringSize in the content
+  void setInlineString(const char *chars, size_t length) {
+    _type = Internals::JSON_INLINE_STRING;
+    for (size_t i = 0; i < length; i++) _content.asInlineString[i] = chars[i];
+    _content.asInlineString[length] = 0;
+  }
+#endif
   bool variantIsString() const {
     return _type == Internals::JSON_STRING ||
+#if ARDUINOJSON_ENABLE_INLINE_STRINGS
+           _type == Internals::JSON_INLINE_STRING ||
+#endif
            (_type == Internals::JSON_UNPARSED && _content.asString &&
             !strcmp("null", _content.asString));
   }
 
+#if ARDUINOJSON_COMPACT_NODES
+  // The various alternatives for the value of the variant.
+  Internals::JsonVariantContent _content;
+
+  // The current type of the variant, a JsonVariantType.
+  // It's last, so that the tail padding can be reused (see ListNode)
+  uint8_t _type;
+#else
   // The current type of the variant
   Internals::JsonVariantType _type;
 
   // The various alternatives for the value of the variant.
   Internals::JsonVariantContent _content;
+#endif
 };
 
 DEPRECATED("Decimal places are ignored, use the float value instead")
@@ -18,21 +18,15 @@
 namespace ArduinoJson {
 
 inline JsonVariant::JsonVariant(const JsonArray &array) {
-  if (array.success()) {
-    _type = Internals::JSON_ARRAY;
-    _content.asArray = const_cast<JsonArray *>(&array);
-  } else {
-    _type = Internals::JSON_UNDEFINED;
-  }
+  // set even when undefined, so that the content is never uninitialized
+  _content.asArray = const_cast<JsonArray *>(&array);
+  _type = array.success() ? Internals::JSON_ARRAY : Internals::JSON_UNDEFINED;
 }
 
 inline JsonVariant::JsonVariant(const JsonObject &object) {
-  if (object.success()) {
-    _type = Internals::JSON_OBJECT;
-    _content.asObject = const_cast<JsonObject *>(&object);
-  } else {
-    _type = Internals::JSON_UNDEFINED;
-  }
+  // set even when undefined, so that the content is never uninitialized
+  _content.asObject = const_cast<JsonObject *>(&object);
+  _type = object.success() ? Internals::JSON_OBJECT : Internals::JSON_UNDEFINED;
 }
 
 inline JsonArray &JsonVariant::variantAsArray() const {
@@ -53,12 +47,16 @@ inline T JsonVariant::variantAsInteger() const {
       return 0;
     case JSON_POSITIVE_INTEGER:
     case JSON_BOOLEAN:
-      return T(_content.asInteger);
+      return clampInteger<T>(_content.asInteger, false);
     case JSON_NEGATIVE_INTEGER:
-      return T(~_content.asInteger + 1);
+      return clampInteger<T>(_content.asInteger, true);
     case JSON_STRING:
     case JSON_UNPARSED:
       return parseInteger<T>(_content.asString);
+#if ARDUINOJSON_ENABLE_INLINE_STRINGS
+    case JSON_INLINE_STRING:
+      return parseInteger<T>(_content.asInlineString);
+#endif
     default:
       return T(_content.asFloat);
   }
@@ -70,6 +68,9 @@ inline const char *JsonVariant::variantAsString() const {
       !strcmp("null", _content.asString))
     return NULL;
   if (_type == JSON_STRING || _type == JSON_UNPARSED) return _content.asString;
+#if ARDUINOJSON_ENABLE_INLINE_STRINGS
+  if (_type == JSON_INLINE_STRING) return _content.asInlineString;
+#endif
   return NULL;
 }
 
@@ -87,6 +88,10 @@ inline T JsonVariant::variantAsFloat() const {
     case JSON_STRING:
     case JSON_UNPARSED:
       return parseFloat<T>(_content.asString);
+#if ARDUINOJSON_ENABLE_INLINE_STRINGS
+    case JSON_INLINE_STRING:
+      return parseFloat<T>(_content.asInlineString);
+#endif
     default:
       return static_cast<T>(_content.asFloat);
   }
@@ -0,0 +1,62 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#pragma once
+
+#include <stddef.h>  // for size_t
+
+#include "Configuration.hpp"
+#include "Data/JsonFloat.hpp"
+
+namespace ArduinoJson {
+namespace Internals {
+
+// Adapts a std::pmr::memory_resource, or any class with the same allocate()
+// and deallocate() functions, to be used as the allocator of a
+// DynamicJsonBuffer or as the upstream of a BlockCache.
+// std::pmr::memory_resource reports a failure by throwing std::bad_alloc, so
+// the exception is caught and turned into a NULL, like the other allocators.
+// When the exceptions are disabled, the resource must return NULL instead.
+template <typename TResource>
+class MemoryResourceAllocator {
+  // keeps the size of the block, as required by deallocate()
+  union Header {
+    size_t size;
+    void *pointer;
+    JsonFloat number;
+  };
+
+ public:
+  explicit MemoryResourceAllocator(TResource *resource)
+      : _resource(resource) {}
+
+  void *allocate(size_t size) {
+    size_t bytes = sizeof(Header) + size;
+    Header *header;
+#if ARDUINOJSON_ENABLE_EXCEPTIONS
+    try {
+      header =
+          static_cast<Header *>(_resource->allocate(bytes, sizeof(Header)));
+    } catch (...) {
+      return NULL;
+    }
+#else
+    header = static_cast<Header *>(_resource->allocate(bytes, sizeof(Header)));
+#endif
+    if (!header) return NULL;
+    header->size = bytes;
+    return header + 1;
+  }
+
+  void deallocate(void *pointer) {
+    if (!pointer) return;
+    Header *header = static_cast<Header *>(pointer) - 1;
+    _resource->deallocate(header, header->size, sizeof(Header));
+  }
+
+ private:
+  TResource *_resource;
+};
+}
+}
@@ -0,0 +1,237 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#pragma once
+
+#include <stdint.h>
+
+#include "../TypeTraits/FloatTraits.hpp"
+#include "./ctype.hpp"
+
+namespace ArduinoJson {
+namespace Internals {
+
+// A decimal number with up to 800 significant digits, that can be multiplied
+// and divided by powers of two without rounding.
+// It's the slow path of parseDouble(): the number is scaled by powers of two
+// until it's in [0.5, 1), and then the bits of the mantissa are read from the
+// digits. 800 digits are more than the 767 that a double may need to be
+// correctly rounded; the ones that follow only tell if the number is above a
+// halfway point.
+// Unlike strtod(), it doesn't depend on the locale.
+class Decimal {
+ public:
+  enum { Capacity = 800 };
+
+  // Reads an unsigned decimal number, like parseDouble()
+  explicit Decimal(const char *s) : _count(0), _point(0), _truncated(false) {
+    bool sawPoint = false;
+    for (;; s++) {
+      if (*s == '.' && !sawPoint) {
+        sawPoint = true;
+        continue;
+      }
+      if (!isdigit(*s)) break;
+      uint8_t digit = static_cast<uint8_t>(*s - '0');
+      if (!digit && !_count) {  // leading zero
+        if (sawPoint) _point--;
+        continue;
+      }
+      if (_count < Capacity)
+        _digits[_count++] = digit;
+      else if (digit)
+        _truncated = true;
+      if (!sawPoint) _point++;
+    }
+
+    if (*s == 'e' || *s == 'E') {
+      s++;
+      bool negativeExponent = false;
+      if (*s == '-') {
+        negativeExponent = true;
+        s++;
+      } else if (*s == '+') {
+        s++;
+      }
+      // beyond that, the result is zero or infinity anyway
+      uint32_t exponent = 0;
+      for (; isdigit(*s); s++)
+        if (exponent < 10000)
+          exponent = exponent * 10 + static_cast<uint8_t>(*s - '0');
+      if (negativeExponent)
+        _point -= static_cast<int>(exponent);
+      else
+        _point += static_cast<int>(exponent);
+    }
+    trim();
+  }
+
+  double toDouble() {
+    typedef FloatTraits<double> traits;
+    const int mantissaBits = 52;
+    const int minExponent = -1022;
+    const int maxExponent = 1023;
+
+    if (!_count || _point < -330) return 0;
+    if (_point > 310) return traits::inf();
+
+    // scales the number to [0.5, 1)
+    int exponent = 0;
+    while (_point > 0) {
+      int n = shiftFor(_point);
+      shift(-n);
+      exponent += n;
+    }
+    while (_point < 0 || (_point == 0 && _digits[0] < 5)) {
+      int n = shiftFor(-_point);
+      shift(n);
+      exponent -= n;
+    }
+    // [0.5, 1) becomes [1, 2)
+    exponent--;
+
+    if (exponent < minExponent) {  // subnormal
+      shift(exponent - minExponent);
+      exponent = minExponent;
+    }
+    if (exponent > maxExponent) return traits::inf();
+
+    shift(mantissaBits + 1);
+    uint64_t mantissa = roundedInteger();
+    // rounding may have added a bit
+    if (mantissa == uint64_t(2) << mantissaBits) {
+      mantissa >>= 1;
+      if (++exponent > maxExponent) return traits::inf();
+    }
+
+    uint64_t bits = mantissa & ((uint64_t(1) << mantissaBits) - 1);
+    if (mantissa & (uint64_t(1) << mantissaBits))
+      bits |= static_cast<uint64_t>(exponent - minExponent + 1) << mantissaBits;
+    return traits::forge(static_cast<uint32_t>(bits >> 32),
+                         static_cast<uint32_t>(bits));
+  }
+
+ private:
+  // The biggest shift that can't overflow a 64-bit accumulator
+  enum { MaxShift = 60 };
+  // The shifts can't be bigger than the headroom of shiftLeft()
+  enum { MaxNewDigits = 19 };
+
+  // Gets a shift that moves the point by about the specified number of digits,
+  // without making the number smaller than 0.5, or bigger than 1
+  static int shiftFor(int digits) {
+    static const uint8_t shifts[] = {1, 3, 6, 9, 13, 16, 19, 23, 26};
+    return digits < 9 ? shifts[digits] : 27;
+  }
+
+  // Multiplies by 2^bits, or divides if bits is negative
+  void shift(int bits) {
+    if (!_count) return;
+    for (; bits > MaxShift; bits -= MaxShift) shiftLeft(MaxShift);
+    for (; bits < -MaxShift; bits += MaxShift) shiftRight(MaxShift);
+    if (bits > 0) shiftLeft(static_cast<uint8_t>(bits));
+    if (bits < 0) shiftRight(static_cast<uint8_t>(-bits));
+  }
+
+  void shiftLeft(uint8_t bits) {
+    // the digits are written backward, after the headroom
+    size_t r = _count;
+    size_t w = _count + MaxNewDigits;
+    uint64_t n = 0;
+    while (r > 0) {
+      n += static_cast<uint64_t>(_digits[--r]) << bits;
+      uint64_t quotient = n / 10;
+      _digits[--w] = static_cast<uint8_t>(n - 10 * quotient);
+      n = quotient;
+    }
+    for (; n > 0; n /= 10) _digits[--w] = static_cast<uint8_t>(n % 10);
+
+    size_t newDigits = MaxNewDigits - w;
+    size_t count = _count + newDigits;
+    for (size_t i = 0; i < count; i++) _digits[i] = _digits[w + i];
+    for (; count > Capacity; count--)
+      if (_digits[count - 1]) _truncated = true;
+    _count = count;
+    _point += static_cast<int>(newDigits);
+    trim();
+  }
+
+  void shiftRight(uint8_t bits) {
+    size_t r = 0;
+    size_t w = 0;
+    uint64_t n = 0;
+    // reads the digits until there is something to shift
+    for (; !(n >> bits); r++) {
+      if (r >= _count) {
+        if (!n) {
+          _count = 0;
+          return;
+        }
+        for (; !(n >> bits); r++) n *= 10;
+        break;
+      }
+      n = n * 10 + _digits[r];
+    }
+    _point -= static_cast<int>(r) - 1;
+
+    uint64_t mask = (uint64_t(1) << bits) - 1;
+    for (; r < _count; r++) {
+      uint8_t digit = static_cast<uint8_t>(n >> bits);
+      n &= mask;
+      _digits[w++] = digit;
+      n = n * 10 + _digits[r];
+    }
+    for (; n > 0; n *= 10) {
+      uint8_t digit = static_cast<uint8_t>(n >> bits);
+      n &= mask;
+      if (w < Capacity)
+        _digits[w++] = digit;
+      else if (digit)
+        _truncated = true;
+    }
+    _count = w;
+    trim();
+  }
+
+  // Gets the integral part, rounded to the nearest, ties to even
+  uint64_t roundedInteger() const {
+    if (_point < 0) return 0;
+    if (_point > 20) return ~uint64_t(0);
+    size_t point = static_cast<size_t>(_point);
+    uint64_t n = 0;
+    for (size_t i = 0; i < point; i++)
+      n = n * 10 + (i < _count ? _digits[i] : 0);
+    if (shouldRoundUp(point)) n++;
+    return n;
+  }
+
+  bool shouldRoundUp(size_t position) const {
+    if (position >= _count) return false;
+    if (_digits[position] == 5 && position + 1 == _count) {  // halfway
+      if (_truncated) return true;
+      return position > 0 && (_digits[position - 1] & 1);
+    }
+    return _digits[position] >= 5;
+  }
+
+  // Removes the trailing zeros
+  void trim() {
+    while (_count > 0 && !_digits[_count - 1]) _count--;
+    if (!_count) _point = 0;
+  }
+
+  // one digit per byte, with room for the digits added by shiftLeft()
+  uint8_t _digits[Capacity + MaxNewDigits];
+  size_t _count;
+  int _point;  // the number of digits before the decimal point
+  bool _truncated;
+};
+
+// Parses an unsigned decimal number into a correctly rounded double, with
+// arbitrary precision.
+inline double decimalToDouble(const char *s) {
+  return Decimal(s).toDouble();
+}
+}
+}
@@ -0,0 +1,41 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#pragma once
+
+#include <stddef.h>  // for size_t
+#include <stdint.h>  // for uint32_t
+
+namespace ArduinoJson {
+namespace Internals {
+
+// Computes the FNV-1a hash of a string, one char at a time
+class StringHasher {
+ public:
+  StringHasher() : _hash(2166136261UL) {}
+
+  void append(char c) {
+    _hash = static_cast<uint32_t>((_hash ^ static_cast<uint8_t>(c)) * 16777619UL);
+  }
+
+  void append(const char* chars, size_t length) {
+    for (size_t i = 0; i < length; i++) append(chars[i]);
+  }
+
+  uint32_t value() const {
+    return _hash;
+  }
+
+ private:
+  uint32_t _hash;
+};
+
+inline uint32_t hashString(const char* s) {
+  StringHasher hasher;
+  if (s)
+    while (*s) hasher.append(*s++);
+  return hasher.value();
+}
+}
+}
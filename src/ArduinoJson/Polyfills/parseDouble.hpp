@@ -0,0 +1,225 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#pragma once
+
+#include <stdint.h>
+
+#include "../TypeTraits/FloatTraits.hpp"
+#include "./ctype.hpp"
+#include "./decimalToDouble.hpp"
+#include "./powersOfFive.hpp"
+
+namespace ArduinoJson {
+namespace Internals {
+
+struct UInt128 {
+  uint64_t high;
+  uint64_t low;
+};
+
+// Computes the full product of two 64-bit integers
+inline UInt128 multiply128(uint64_t a, uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+  __extension__ typedef unsigned __int128 uint128_t;
+  uint128_t product = static_cast<uint128_t>(a) * b;
+  UInt128 result;
+  result.low = static_cast<uint64_t>(product);
+  result.high = static_cast<uint64_t>(product >> 64);
+  return result;
+#else
+  uint64_t aLow = a & 0xFFFFFFFF, aHigh = a >> 32;
+  uint64_t bLow = b & 0xFFFFFFFF, bHigh = b >> 32;
+  uint64_t ll = aLow * bLow;
+  uint64_t lh = aLow * bHigh;
+  uint64_t hl = aHigh * bLow;
+  uint64_t hh = aHigh * bHigh;
+  uint64_t middle = (ll >> 32) + (lh & 0xFFFFFFFF) + (hl & 0xFFFFFFFF);
+  UInt128 result;
+  result.low = (middle << 32) | (ll & 0xFFFFFFFF);
+  result.high = hh + (lh >> 32) + (hl >> 32) + (middle >> 32);
+  return result;
+#endif
+}
+
+inline int countLeadingZeros(uint64_t x) {
+#if defined(__GNUC__)
+  return __builtin_clzll(x);
+#else
+  int n = 0;
+  while (!(x >> 63)) {
+    x <<= 1;
+    n++;
+  }
+  return n;
+#endif
+}
+
+// Computes w * 10^q with the Eisel-Lemire algorithm.
+// w must not be zero. Returns false in the rare cases where the 128-bit
+// approximation of 5^q is not enough to decide the rounding.
+inline bool eiselLemire(uint64_t w, int q, double &result) {
+  typedef FloatTraits<double> traits;
+  const int mantissaBits = 52;
+
+  if (q < PowersOfFive::smallest) {
+    result = 0;
+    return true;
+  }
+  if (q > PowersOfFive::largest) {
+    result = traits::inf();
+    return true;
+  }
+
+  int lz = countLeadingZeros(w);
+  w <<= lz;
+
+  // 55 bits are enough, unless the bits that follow are all ones
+  const uint64_t precisionMask = ~uint64_t(0) >> (mantissaBits + 3);
+  UInt128 product = multiply128(w, PowersOfFive::get(q, 0));
+  if ((product.high & precisionMask) == precisionMask) {
+    UInt128 lowProduct = multiply128(w, PowersOfFive::get(q, 1));
+    product.low += lowProduct.high;
+    if (lowProduct.high > product.low) product.high++;
+    if (product.low == ~uint64_t(0) && (q < -27 || q > 55)) return false;
+  }
+
+  int upperBit = static_cast<int>(product.high >> 63);
+  int shift = upperBit + 64 - mantissaBits - 3;
+  uint64_t mantissa = product.high >> shift;
+  // floor(log2(10^q)) + 63, plus the exponent bias
+  int power2 = (((152170 + 65536) * q) >> 16) + 63 + upperBit - lz + 1023;
+
+  if (power2 <= 0) {  // subnormal
+    if (power2 <= -63) {
+      result = 0;
+      return true;
+    }
+    mantissa >>= 1 - power2;
+    mantissa += mantissa & 1;
+    mantissa >>= 1;
+    // rounding may have produced the smallest normal number
+    power2 = mantissa < (uint64_t(1) << mantissaBits) ? 0 : 1;
+  } else {
+    // exactly halfway between two doubles: round to even
+    if (product.low <= 1 && q >= -4 && q <= 23 && (mantissa & 3) == 1 &&
+        (mantissa << shift) == product.high)
+      mantissa &= ~uint64_t(1);
+    mantissa += mantissa & 1;
+    mantissa >>= 1;
+    if (mantissa >= (uint64_t(2) << mantissaBits)) {
+      mantissa = uint64_t(1) << mantissaBits;
+      power2++;
+    }
+    if (power2 >= 0x7FF) {
+      result = traits::inf();
+      return true;
+    }
+  }
+
+  mantissa &= ~(uint64_t(1) << mantissaBits);
+  mantissa |= static_cast<uint64_t>(power2) << mantissaBits;
+  result = traits::forge(static_cast<uint32_t>(mantissa >> 32),
+                         static_cast<uint32_t>(mantissa));
+  return true;
+}
+
+// Computes w * 10^q when both are exactly representable as doubles, so that
+// a single multiplication or division gives the correctly rounded result
+inline bool clingerFastPath(uint64_t w, int q, double &result) {
+#if defined(__FLT_EVAL_METHOD__) && __FLT_EVAL_METHOD__ != 0
+  // the x87 FPU rounds twice
+  (void)w;
+  (void)q;
+  (void)result;
+  return false;
+#else
+  static const double powersOfTen[] = {
+      1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+      1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+  if (q < -22 || q > 22 || w > (uint64_t(1) << 53)) return false;
+  result = static_cast<double>(w);
+  if (q < 0)
+    result /= powersOfTen[-q];
+  else
+    result *= powersOfTen[q];
+  return true;
+#endif
+}
+
+// Counts the significant digits of a number, without the leading zeros
+inline size_t countSignificantDigits(const char *s) {
+  while (*s == '0' || *s == '.') s++;
+  size_t count = 0;
+  for (; isdigit(*s) || *s == '.'; s++)
+    if (*s != '.') count++;
+  return count;
+}
+
+// Parses an unsigned decimal number into a correctly rounded double
+// (see ARDUINOJSON_ENABLE_EXACT_FLOAT_PARSING).
+// Falls back to decimalToDouble() when the number has more than 19
+// significant digits, or when the fast algorithm can't decide the rounding.
+// The counts are unsigned and bounded, so that the compiler has no signed
+// overflow to assume away (-Wstrict-overflow).
+inline double parseDouble(const char *s) {
+  const char *start = s;
+  const size_t maxDigits = 19;  // the most that always fit in 64 bits
+  // beyond that, the result is zero or infinity anyway
+  const uint32_t maxExponent = 100000;
+  uint64_t mantissa = 0;
+
+  // the mantissa may overflow, the digits are counted after the loops
+  const char *integerPart = s;
+  for (; isdigit(*s); s++)
+    mantissa = mantissa * 10 + static_cast<uint8_t>(*s - '0');
+  size_t digits = static_cast<size_t>(s - integerPart);
+
+  uint32_t fractionalDigits = 0;
+  if (*s == '.') {
+    const char *fractionalPart = ++s;
+    for (; isdigit(*s); s++)
+      mantissa = mantissa * 10 + static_cast<uint8_t>(*s - '0');
+    size_t length = static_cast<size_t>(s - fractionalPart);
+    digits += length;
+    fractionalDigits = static_cast<uint32_t>(
+        length < maxExponent ? length : maxExponent);
+  }
+
+  bool truncated =
+      digits > maxDigits && countSignificantDigits(start) > maxDigits;
+
+  bool negativeExponent = false;
+  uint32_t explicitExponent = 0;
+  if (*s == 'e' || *s == 'E') {
+    s++;
+    if (*s == '-') {
+      negativeExponent = true;
+      s++;
+    } else if (*s == '+') {
+      s++;
+    }
+    for (; isdigit(*s); s++) {
+      if (explicitExponent < maxExponent)
+        explicitExponent =
+            explicitExponent * 10 + static_cast<uint8_t>(*s - '0');
+    }
+  }
+
+  // both terms are below 10 * maxExponent
+  int exponent = negativeExponent
+                     ? -static_cast<int>(explicitExponent + fractionalDigits)
+                     : static_cast<int>(explicitExponent) -
+                           static_cast<int>(fractionalDigits);
+
+  if (!mantissa && !truncated) return 0;
+
+  double result;
+  if (!truncated && (clingerFastPath(mantissa, exponent, result) ||
+                     eiselLemire(mantissa, exponent, result)))
+    return result;
+  return decimalToDouble(start);
+}
+}
+}
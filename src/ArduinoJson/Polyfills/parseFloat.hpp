@@ -4,10 +4,15 @@
 
 #pragma once
 
+#include "../Configuration.hpp"
 #include "../TypeTraits/FloatTraits.hpp"
 #include "./ctype.hpp"
 #include "./math.hpp"
 
+#if ARDUINOJSON_ENABLE_EXACT_FLOAT_PARSING
+#include "./parseDouble.hpp"
+#endif
+
 namespace ArduinoJson {
 namespace Internals {
 
@@ -35,6 +40,13 @@ inline T parseFloat(const char* s) {
   if (*s == 'i' || *s == 'I')
     return negative_result ? -traits::inf() : traits::inf();
 
+#if ARDUINOJSON_ENABLE_EXACT_FLOAT_PARSING
+  if (sizeof(T) == sizeof(double)) {
+    T result = static_cast<T>(parseDouble(s));
+    return negative_result ? -result : result;
+  }
+#endif
+
   mantissa_t mantissa = 0;
   exponent_t exponent_offset = 0;
 
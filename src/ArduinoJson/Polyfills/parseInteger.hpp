@@ -5,21 +5,99 @@
 #pragma once
 
 #include <stdlib.h>
+#include <string.h>  // for memcpy
 
 #include "../Configuration.hpp"
+#include "../Data/JsonInteger.hpp"
 #include "./ctype.hpp"
 
+#if ARDUINOJSON_ENABLE_FAST_INTEGER_PARSING && defined(__BYTE_ORDER__) && \
+    __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#include <stdint.h>
+#define ARDUINOJSON_PARSE_EIGHT_DIGITS 1
+#else
+#define ARDUINOJSON_PARSE_EIGHT_DIGITS 0
+#endif
+
 namespace ArduinoJson {
 namespace Internals {
+
+// The magnitudes of the largest and of the smallest value of an integer type
 template <typename T>
-T parseInteger(const char *s) {
-  if (!s) return 0;  // NULL
+struct IntegerLimits {
+  static const bool isSigned = T(-1) < T(0);
+  static const JsonUInt highestBit = JsonUInt(1) << (8 * sizeof(T) - 1);
+  static const JsonUInt maxPositive =
+      isSigned ? highestBit - 1 : highestBit - 1 + highestBit;
+  static const JsonUInt maxNegative = isSigned ? highestBit : 0;
+};
 
-  if (*s == 't') return 1;  // "true"
+#if ARDUINOJSON_PARSE_EIGHT_DIGITS
+// Converts eight decimal digits at once, with three multiplications
+// (see ARDUINOJSON_ENABLE_FAST_INTEGER_PARSING)
+inline uint32_t parseEightDigits(const char *s) {
+  const uint64_t zeros = (uint64_t(0x30303030) << 32) | 0x30303030;
+  const uint64_t mask = (uint64_t(0xFF) << 32) | 0xFF;
+  uint64_t value;
+  memcpy(&value, s, 8);
+  value -= zeros;
+  // pairs of digits in each 16-bit word
+  value = value * 10 + (value >> 8);
+  // groups of four digits, then the eight digits in the upper half
+  value = ((value & mask) * ((uint64_t(1000000) << 32) + 100) +
+           ((value >> 16) & mask) * ((uint64_t(10000) << 32) + 1)) >>
+          32;
+  return static_cast<uint32_t>(value);
+}
+#endif
 
-  T result = 0;
-  bool negative_result = false;
+// Converts a run of decimal digits that fits in a JsonUInt
+inline JsonUInt parseDigits(const char *s, size_t length) {
+  JsonUInt result = 0;
+#if ARDUINOJSON_PARSE_EIGHT_DIGITS
+  for (; length >= 8; length -= 8, s += 8)
+    result = result * 100000000 + parseEightDigits(s);
+#endif
+  for (; length > 0; length--, s++)
+    result = result * 10 + static_cast<uint8_t>(*s - '0');
+  return result;
+}
+
+// Converts a magnitude and a sign to T, saturating to the limits of T.
+// Returns false if the value doesn't fit in a T.
+template <typename T>
+bool clampInteger(JsonUInt magnitude, bool negative, T &result) {
+  typedef IntegerLimits<T> limits;
+  JsonUInt limit = negative ? limits::maxNegative : limits::maxPositive;
+  bool fits = magnitude <= limit;
+  if (!fits) magnitude = limit;
+  result = negative ? T(~magnitude + 1) : T(magnitude);
+  return fits;
+}
+
+template <typename T>
+T clampInteger(JsonUInt magnitude, bool negative) {
+  T result;
+  clampInteger(magnitude, negative, result);
+  return result;
+}
 
+// Parses an integer, saturating to the limits of T.
+// Returns false if the value doesn't fit in a T.
+template <typename T>
+bool parseInteger(const char *s, T &result) {
+  // the number of digits of the largest JsonUInt
+  const size_t maxDigits = sizeof(JsonUInt) >= 8 ? 20 : 10;
+
+  result = 0;
+  if (!s) return true;  // NULL
+
+  if (*s == 't') {  // "true"
+    result = 1;
+    return true;
+  }
+
+  bool negative_result = false;
   switch (*s) {
     case '-':
       negative_result = true;
@@ -30,12 +108,34 @@ T parseInteger(const char *s) {
       break;
   }
 
-  while (isdigit(*s)) {
-    result = T(result * 10 + T(*s - '0'));
-    s++;
+  while (*s == '0') s++;
+  const char *digits = s;
+  while (isdigit(*s)) s++;
+  size_t length = static_cast<size_t>(s - digits);
+  if (!length) return true;
+
+  bool fits = length <= maxDigits;
+  JsonUInt magnitude = 0;
+  if (fits) {
+    // only the last digit may overflow the JsonUInt
+    magnitude = parseDigits(digits, length - 1);
+    uint8_t last = static_cast<uint8_t>(digits[length - 1] - '0');
+    if (length == maxDigits && magnitude > (JsonUInt(~JsonUInt(0)) - last) / 10)
+      fits = false;
+    else
+      magnitude = magnitude * 10 + last;
   }
+  // too many digits: the largest magnitude saturates too
+  if (!fits) magnitude = JsonUInt(~JsonUInt(0));
+
+  return clampInteger(magnitude, negative_result, result) && fits;
+}
 
-  return negative_result ? T(~result + 1) : result;
+template <typename T>
+T parseInteger(const char *s) {
+  T result;
+  parseInteger(s, result);
+  return result;
 }
 }
 }
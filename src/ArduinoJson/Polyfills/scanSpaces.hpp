@@ -0,0 +1,66 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#pragma once
+
+#include <stddef.h>  // size_t
+
+#include "./simd.hpp"
+
+namespace ArduinoJson {
+namespace Internals {
+
+inline bool isSpace(char c) {
+  return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+// Counts the spaces, tabs and line breaks at the beginning of s.
+// The characters are tested 32 or 16 at a time with AVX2 or SSE2, as long as
+// a whole vector is available; the remaining ones are tested one by one.
+inline size_t scanSpaces(const char *s, size_t available) {
+  size_t i = 0;
+
+#if ARDUINOJSON_HAS_AVX2
+  {
+    const __m256i spaces = _mm256_set1_epi8(' ');
+    const __m256i tabs = _mm256_set1_epi8('\t');
+    const __m256i returns = _mm256_set1_epi8('\r');
+    const __m256i newlines = _mm256_set1_epi8('\n');
+    for (; i + 32 <= available; i += 32) {
+      __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i));
+      __m256i blank = _mm256_or_si256(
+          _mm256_or_si256(_mm256_cmpeq_epi8(v, spaces),
+                          _mm256_cmpeq_epi8(v, tabs)),
+          _mm256_or_si256(_mm256_cmpeq_epi8(v, returns),
+                          _mm256_cmpeq_epi8(v, newlines)));
+      unsigned mask = ~static_cast<unsigned>(_mm256_movemask_epi8(blank));
+      if (mask) return i + static_cast<size_t>(__builtin_ctz(mask));
+    }
+  }
+#endif
+
+#if ARDUINOJSON_HAS_SSE2
+  {
+    const __m128i spaces = _mm_set1_epi8(' ');
+    const __m128i tabs = _mm_set1_epi8('\t');
+    const __m128i returns = _mm_set1_epi8('\r');
+    const __m128i newlines = _mm_set1_epi8('\n');
+    for (; i + 16 <= available; i += 16) {
+      __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i));
+      __m128i blank =
+          _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, spaces),
+                                    _mm_cmpeq_epi8(v, tabs)),
+                       _mm_or_si128(_mm_cmpeq_epi8(v, returns),
+                                    _mm_cmpeq_epi8(v, newlines)));
+      unsigned mask = ~static_cast<unsigned>(_mm_movemask_epi8(blank)) & 0xFFFF;
+      if (mask) return i + static_cast<size_t>(__builtin_ctz(mask));
+    }
+  }
+#endif
+
+  while (i < available && isSpace(s[i])) i++;
+  return i;
+}
+}
+}
@@ -0,0 +1,78 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#pragma once
+
+#include <stddef.h>  // size_t
+#include <string.h>  // memcpy
+
+#include "./simd.hpp"
+
+namespace ArduinoJson {
+namespace Internals {
+
+// Counts the characters of a quoted string that can be copied as they are:
+// the ones before the closing quote, a backslash or a terminator.
+// The characters are tested 32 or 16 at a time with AVX2 or SSE2, then a
+// word at a time (SWAR), as long as a whole vector or word is available; the
+// remaining ones are tested one by one.
+inline size_t scanString(const char *s, size_t available, char quote) {
+  size_t i = 0;
+
+#if ARDUINOJSON_HAS_AVX2
+  {
+    const __m256i quotes = _mm256_set1_epi8(quote);
+    const __m256i backslashes = _mm256_set1_epi8('\\');
+    const __m256i zeros = _mm256_setzero_si256();
+    for (; i + 32 <= available; i += 32) {
+      __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i));
+      __m256i special = _mm256_or_si256(
+          _mm256_or_si256(_mm256_cmpeq_epi8(v, quotes),
+                          _mm256_cmpeq_epi8(v, backslashes)),
+          _mm256_cmpeq_epi8(v, zeros));
+      unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(special));
+      if (mask) return i + static_cast<size_t>(__builtin_ctz(mask));
+    }
+  }
+#endif
+
+#if ARDUINOJSON_HAS_SSE2
+  {
+    const __m128i quotes = _mm_set1_epi8(quote);
+    const __m128i backslashes = _mm_set1_epi8('\\');
+    const __m128i zeros = _mm_setzero_si128();
+    for (; i + 16 <= available; i += 16) {
+      __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i));
+      __m128i special =
+          _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, quotes),
+                                    _mm_cmpeq_epi8(v, backslashes)),
+                       _mm_cmpeq_epi8(v, zeros));
+      unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(special));
+      if (mask) return i + static_cast<size_t>(__builtin_ctz(mask));
+    }
+  }
+#endif
+
+  typedef size_t word_t;
+  const word_t ones = word_t(~word_t(0)) / 255;  // 0x0101...
+  const word_t highs = ones * 0x80;              // 0x8080...
+  const word_t quotes = ones * static_cast<unsigned char>(quote);
+  const word_t backslashes = ones * '\\';
+
+  for (; i + sizeof(word_t) <= available; i += sizeof(word_t)) {
+    word_t w;
+    memcpy(&w, s + i, sizeof(word_t));
+    // a byte of x is zero if x - 0x01 borrows and x had no high bit
+    word_t q = w ^ quotes, b = w ^ backslashes;
+    word_t special = ((w - ones) & ~w) | ((q - ones) & ~q) | ((b - ones) & ~b);
+    if (special & highs) break;
+  }
+  for (; i < available; i++) {
+    char c = s[i];
+    if (c == quote || c == '\\' || c == '\0') break;
+  }
+  return i;
+}
+}
+}
@@ -0,0 +1,97 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#pragma once
+
+#include <stddef.h>  // size_t
+
+#include "./simd.hpp"
+
+namespace ArduinoJson {
+namespace Internals {
+
+// Tells whether a character can be in an unquoted value, like a number,
+// true, false, null or an unquoted key
+inline bool isTokenChar(char c) {
+  return ('0' <= c && c <= '9') || ('_' <= c && c <= 'z') ||
+         ('A' <= c && c <= 'Z') || c == '+' || c == '-' || c == '.';
+}
+
+// Counts the characters of an unquoted value: the ones before the next
+// structural character, space, quote or terminator.
+// The characters are tested 32 or 16 at a time with AVX2 or SSE2, as long as
+// a whole vector is available; the remaining ones are tested one by one.
+// The vectors are compared as signed bytes, so the characters above 0x7F are
+// never in a range, like with isTokenChar().
+inline size_t scanToken(const char *s, size_t available) {
+  size_t i = 0;
+
+#if ARDUINOJSON_HAS_AVX2
+  {
+    // '+', then '-' and '.', then the digits, the capitals and the lowercase
+    const __m256i plus = _mm256_set1_epi8('+');
+    const __m256i belowMinus = _mm256_set1_epi8('-' - 1);
+    const __m256i aboveDot = _mm256_set1_epi8('.' + 1);
+    const __m256i belowZero = _mm256_set1_epi8('0' - 1);
+    const __m256i aboveNine = _mm256_set1_epi8('9' + 1);
+    const __m256i belowA = _mm256_set1_epi8('A' - 1);
+    const __m256i aboveZ = _mm256_set1_epi8('Z' + 1);
+    const __m256i belowUnderscore = _mm256_set1_epi8('_' - 1);
+    const __m256i aboveLowerZ = _mm256_set1_epi8('z' + 1);
+    for (; i + 32 <= available; i += 32) {
+      __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i));
+      __m256i token = _mm256_or_si256(
+          _mm256_or_si256(
+              _mm256_cmpeq_epi8(v, plus),
+              _mm256_and_si256(_mm256_cmpgt_epi8(v, belowMinus),
+                               _mm256_cmpgt_epi8(aboveDot, v))),
+          _mm256_or_si256(
+              _mm256_or_si256(
+                  _mm256_and_si256(_mm256_cmpgt_epi8(v, belowZero),
+                                   _mm256_cmpgt_epi8(aboveNine, v)),
+                  _mm256_and_si256(_mm256_cmpgt_epi8(v, belowA),
+                                   _mm256_cmpgt_epi8(aboveZ, v))),
+              _mm256_and_si256(_mm256_cmpgt_epi8(v, belowUnderscore),
+                               _mm256_cmpgt_epi8(aboveLowerZ, v))));
+      unsigned mask = ~static_cast<unsigned>(_mm256_movemask_epi8(token));
+      if (mask) return i + static_cast<size_t>(__builtin_ctz(mask));
+    }
+  }
+#endif
+
+#if ARDUINOJSON_HAS_SSE2
+  {
+    const __m128i plus = _mm_set1_epi8('+');
+    const __m128i belowMinus = _mm_set1_epi8('-' - 1);
+    const __m128i aboveDot = _mm_set1_epi8('.' + 1);
+    const __m128i belowZero = _mm_set1_epi8('0' - 1);
+    const __m128i aboveNine = _mm_set1_epi8('9' + 1);
+    const __m128i belowA = _mm_set1_epi8('A' - 1);
+    const __m128i aboveZ = _mm_set1_epi8('Z' + 1);
+    const __m128i belowUnderscore = _mm_set1_epi8('_' - 1);
+    const __m128i aboveLowerZ = _mm_set1_epi8('z' + 1);
+    for (; i + 16 <= available; i += 16) {
+      __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i));
+      __m128i token = _mm_or_si128(
+          _mm_or_si128(_mm_cmpeq_epi8(v, plus),
+                       _mm_and_si128(_mm_cmpgt_epi8(v, belowMinus),
+                                     _mm_cmplt_epi8(v, aboveDot))),
+          _mm_or_si128(
+              _mm_or_si128(_mm_and_si128(_mm_cmpgt_epi8(v, belowZero),
+                                         _mm_cmplt_epi8(v, aboveNine)),
+                           _mm_and_si128(_mm_cmpgt_epi8(v, belowA),
+                                         _mm_cmplt_epi8(v, aboveZ))),
+              _mm_and_si128(_mm_cmpgt_epi8(v, belowUnderscore),
+                            _mm_cmplt_epi8(v, aboveLowerZ))));
+      unsigned mask = ~static_cast<unsigned>(_mm_movemask_epi8(token)) & 0xFFFF;
+      if (mask) return i + static_cast<size_t>(__builtin_ctz(mask));
+    }
+  }
+#endif
+
+  while (i < available && isTokenChar(s[i])) i++;
+  return i;
+}
+}
+}
@@ -0,0 +1,24 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#pragma once
+
+#include "../Configuration.hpp"
+
+// The vector instructions enabled by the compiler flags, when
+// ARDUINOJSON_ENABLE_SIMD is set (SSE2 is always there on x86-64, AVX2
+// requires -mavx2 or -march=native)
+#if ARDUINOJSON_ENABLE_SIMD && defined(__GNUC__) && defined(__SSE2__)
+#define ARDUINOJSON_HAS_SSE2 1
+#include <emmintrin.h>
+#else
+#define ARDUINOJSON_HAS_SSE2 0
+#endif
+
+#if ARDUINOJSON_HAS_SSE2 && defined(__AVX2__)
+#define ARDUINOJSON_HAS_AVX2 1
+#include <immintrin.h>
+#else
+#define ARDUINOJSON_HAS_AVX2 0
+#endif
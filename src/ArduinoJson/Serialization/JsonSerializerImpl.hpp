@@ -82,6 +82,12 @@ inline void ArduinoJson::Internals::JsonSerializer<Writer>::serialize(
       writer.writeString(variant._content.asString);
       return;
 
+#if ARDUINOJSON_ENABLE_INLINE_STRINGS
+    case JSON_INLINE_STRING:
+      writer.writeString(variant._content.asInlineString);
+      return;
+#endif
+
     case JSON_UNPARSED:
       writer.writeRaw(variant._content.asString);
       return;
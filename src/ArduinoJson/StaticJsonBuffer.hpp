@@ -4,12 +4,14 @@
 
 #pragma once
 
+#include "Data/JsonBufferStats.hpp"
 #include "JsonBufferBase.hpp"
 
 namespace ArduinoJson {
 namespace Internals {
 
-class StaticJsonBufferBase : public JsonBufferBase<StaticJsonBufferBase> {
+class StaticJsonBufferBase : public JsonBufferBase<StaticJsonBufferBase>,
+                             private JsonBufferStatsRecorder {
  public:
   class String {
    public:
@@ -21,13 +23,25 @@ class StaticJsonBufferBase : public JsonBufferBase<StaticJsonBufferBase> {
       if (_parent->canAlloc(1)) {
         char* last = static_cast<char*>(_parent->doAlloc(1));
         *last = c;
+        _parent->recordRequest(1);
       }
     }
 
+    void append(const char* chars, size_t length) {
+      if (!_parent->canAlloc(length)) {
+        // keeps what fits, like the other overload
+        for (size_t i = 0; i < length; i++) append(chars[i]);
+        return;
+      }
+      memcpy(_parent->doAlloc(length), chars, length);
+      _parent->recordRequest(length);
+    }
+
     const char* c_str() const {
       if (_parent->canAlloc(1)) {
         char* last = static_cast<char*>(_parent->doAlloc(1));
         *last = '\0';
+        _parent->recordRequest(1);
         return _start;
       } else {
         return NULL;
@@ -40,7 +54,9 @@ class StaticJsonBufferBase : public JsonBufferBase<StaticJsonBufferBase> {
   };
 
   StaticJsonBufferBase(char* buffer, size_t capa)
-      : _buffer(buffer), _capacity(capa), _size(0) {}
+      : _buffer(buffer), _capacity(capa), _size(0) {
+    recordNewBlock(capa);
+  }
 
   // Gets the capacity of the buffer in bytes
   size_t capacity() const {
@@ -52,19 +68,48 @@ class StaticJsonBufferBase : public JsonBufferBase<StaticJsonBufferBase> {
     return _size;
   }
 
+#if ARDUINOJSON_ENABLE_STATS
+  // Gets the statistics about the memory usage
+  JsonBufferStats stats() const {
+    return getStats(_size, 0);
+  }
+#endif
+
   // Allocates the specified amount of bytes in the buffer
   virtual void* alloc(size_t bytes) {
     alignNextAlloc();
     if (!canAlloc(bytes)) return NULL;
+    recordRequest(bytes);
     return doAlloc(bytes);
   }
 
   // Resets the buffer.
   // USE WITH CAUTION: this invalidates all previously allocated data
   void clear() {
+    recordClear(_size);
     _size = 0;
   }
 
+  // A position in the buffer, returned by mark()
+  struct Mark : Checkpoint {
+    size_t size;
+  };
+
+  // Saves the current position, to go back to it with release()
+  Mark mark() const {
+    Mark m;
+    static_cast<Checkpoint&>(m) = checkpoint();
+    m.size = _size;
+    return m;
+  }
+
+  // Frees everything that was allocated after the mark.
+  // USE WITH CAUTION: this invalidates the data allocated after the mark
+  void release(const Mark& m) {
+    recordRelease(_size, m);
+    _size = m.size;
+  }
+
   String startString() {
     return String(this);
   }
@@ -74,7 +119,9 @@ class StaticJsonBufferBase : public JsonBufferBase<StaticJsonBufferBase> {
 
  private:
   void alignNextAlloc() {
-    _size = round_size_up(_size);
+    size_t alignedSize = round_size_up(_size);
+    recordPadding(alignedSize - _size);
+    _size = alignedSize;
   }
 
   bool canAlloc(size_t bytes) const {
@@ -35,6 +35,14 @@ struct ArduinoStreamTraits {
       return _next;
     }
 
+    // The characters are read one by one
+    size_t peek(const char*& chars) const {
+      chars = NULL;
+      return 0;
+    }
+
+    void skip(size_t) {}
+
    private:
     char read() {
       // don't use _stream.read() as it ignores the timeout
@@ -11,15 +11,31 @@ template <typename TChar>
 struct CharPointerTraits {
   class Reader {
     const TChar* _ptr;
+    const TChar* _end;
 
    public:
     Reader(const TChar* ptr)
-        : _ptr(ptr ? ptr : reinterpret_cast<const TChar*>("")) {}
+        : _ptr(ptr ? ptr : reinterpret_cast<const TChar*>("")),
+          _end(_ptr + strlen(reinterpret_cast<const char*>(_ptr))) {}
+
+    Reader(const TChar* ptr, size_t length)
+        : _ptr(ptr ? ptr : reinterpret_cast<const TChar*>("")),
+          _end(ptr ? ptr + length : _ptr) {}
 
     void move() {
       ++_ptr;
     }
 
+    // Gets the characters that can be read in bulk, and their number
+    size_t peek(const char*& chars) const {
+      chars = reinterpret_cast<const char*>(_ptr);
+      return size_t(_end - _ptr);
+    }
+
+    void skip(size_t count) {
+      _ptr += count;
+    }
+
     char current() const {
       return char(_ptr[0]);
     }
@@ -30,7 +46,13 @@ struct CharPointerTraits {
   };
 
   static bool equals(const TChar* str, const char* expected) {
-    return strcmp(reinterpret_cast<const char*>(str), expected) == 0;
+    const char* actual = reinterpret_cast<const char*>(str);
+    // keys from a JsonKeyTable are compared by address
+    return actual == expected || strcmp(actual, expected) == 0;
+  }
+
+  static uint32_t hash(const TChar* str) {
+    return hashString(reinterpret_cast<const char*>(str));
   }
 
   static bool is_null(const TChar* str) {
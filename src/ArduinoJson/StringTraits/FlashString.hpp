@@ -28,12 +28,28 @@ struct StringTraits<const __FlashStringHelper*, void> {
     char next() const {
       return pgm_read_byte_near(_ptr + 1);
     }
+
+    // The characters are read one by one
+    size_t peek(const char*& chars) const {
+      chars = NULL;
+      return 0;
+    }
+
+    void skip(size_t) {}
   };
 
   static bool equals(const __FlashStringHelper* str, const char* expected) {
     return strcmp_P(expected, (const char*)str) == 0;
   }
 
+  static uint32_t hash(const __FlashStringHelper* str) {
+    const char* p = reinterpret_cast<const char*>(str);
+    StringHasher hasher;
+    for (char c = pgm_read_byte_near(p); c; c = pgm_read_byte_near(++p))
+      hasher.append(c);
+    return hasher.value();
+  }
+
   static bool is_null(const __FlashStringHelper* str) {
     return !str;
   }
@@ -35,6 +35,14 @@ struct StdStreamTraits {
       return _next;
     }
 
+    // The characters are read one by one
+    size_t peek(const char*& chars) const {
+      chars = NULL;
+      return 0;
+    }
+
+    void skip(size_t) {}
+
    private:
     Reader& operator=(const Reader&);  // Visual Studio C4512
 
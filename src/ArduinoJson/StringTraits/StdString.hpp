@@ -36,13 +36,18 @@ struct StdStringTraits {
   }
 
   struct Reader : CharPointerTraits<char>::Reader {
-    Reader(const TString& str) : CharPointerTraits<char>::Reader(str.c_str()) {}
+    Reader(const TString& str)
+        : CharPointerTraits<char>::Reader(str.c_str(), str.length()) {}
   };
 
   static bool equals(const TString& str, const char* expected) {
     return 0 == strcmp(str.c_str(), expected);
   }
 
+  static uint32_t hash(const TString& str) {
+    return hashString(str.c_str());
+  }
+
   static void append(TString& str, char c) {
     str += c;
   }
@@ -6,6 +6,7 @@
 
 #include <string.h>
 #include "../Configuration.hpp"
+#include "../Polyfills/hash.hpp"
 #include "../TypeTraits/EnableIf.hpp"
 #include "../TypeTraits/IsBaseOf.hpp"
 #include "../TypeTraits/IsChar.hpp"
@@ -0,0 +1,61 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#define ARDUINOJSON_COMPACT_NODES 1
+#include <ArduinoJson.h>
+#include <catch.hpp>
+#include <string>
+
+static std::string toJson(const JsonVariant& variant) {
+  std::string json;
+  variant.printTo(json);
+  return json;
+}
+
+TEST_CASE("ARDUINOJSON_COMPACT_NODES") {
+  DynamicJsonBuffer jb;
+
+#if defined(__GNUC__)
+  SECTION("Array nodes are smaller") {
+    if (sizeof(void*) == 8) REQUIRE(16 == sizeof(JsonArray::node_type));
+  }
+#endif
+
+  SECTION("JsonArray") {
+    JsonArray& arr = jb.createArray();
+    arr.add(1);
+    arr.add("two");
+    arr.add(3.5);
+    arr.remove(1);
+    arr.add(false);
+    REQUIRE(3 == arr.size());
+    REQUIRE(std::string("[1,3.5,false]") == toJson(arr));
+
+    int sum = 0;
+    for (JsonArray::iterator it = arr.begin(); it != arr.end(); ++it)
+      sum += it->as<int>();
+    REQUIRE(4 == sum);
+  }
+
+  SECTION("JsonObject") {
+    JsonObject& obj = jb.parseObject("{\"a\":1,\"b\":[2,3],\"c\":{\"d\":4}}");
+    REQUIRE(obj.success());
+    obj.remove("a");
+    obj["e"] = "five";
+    REQUIRE(std::string("{\"b\":[2,3],\"c\":{\"d\":4},\"e\":\"five\"}") ==
+            toJson(obj));
+    REQUIRE(4 == obj["c"]["d"].as<int>());
+  }
+
+  SECTION("Many blocks") {
+    JsonArray& arr = jb.createArray();
+    for (int i = 0; i < 100000; i++) REQUIRE(arr.add(i));
+    REQUIRE(99999 == arr[99999].as<int>());
+
+    DynamicJsonBuffer other;
+    JsonArray& copy = other.clone(arr).as<JsonArray&>();
+    REQUIRE(100000 == copy.size());
+    REQUIRE(12345 == copy[12345].as<int>());
+  }
+}
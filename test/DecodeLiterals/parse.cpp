@@ -0,0 +1,93 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#define ARDUINOJSON_DECODE_LITERALS 1
+#include <ArduinoJson.h>
+#include <catch.hpp>
+#include <string>
+
+static std::string toJson(const JsonVariant& variant) {
+  std::string json;
+  variant.printTo(json);
+  return json;
+}
+
+static size_t sizeAfterParse(const char* json) {
+  DynamicJsonBuffer jb;
+  REQUIRE(jb.parse(json).success());
+  return jb.size();
+}
+
+TEST_CASE("ARDUINOJSON_DECODE_LITERALS") {
+  DynamicJsonBuffer jb;
+
+  SECTION("Integers") {
+    JsonArray& arr = jb.parseArray("[42,-42,+7]");
+    REQUIRE(arr[0].is<int>());
+    REQUIRE(42 == arr[0].as<int>());
+    REQUIRE(-42 == arr[1].as<long>());
+    REQUIRE(7 == arr[2].as<int>());
+    REQUIRE(arr[0].is<float>());
+    REQUIRE(NULL == arr[0].as<char*>());
+  }
+
+  SECTION("Integers that don't fit") {
+    JsonArray& arr = jb.parseArray("[128,300,-129]");
+    REQUIRE(127 == arr[0].as<signed char>());
+    REQUIRE(255 == arr[1].as<unsigned char>());
+    REQUIRE(-128 == arr[2].as<signed char>());
+    REQUIRE(0 == arr[2].as<unsigned char>());
+  }
+
+  SECTION("Floats") {
+    JsonArray& arr = jb.parseArray("[1.5,-2e3]");
+    REQUIRE(arr[0].is<double>());
+    REQUIRE_FALSE(arr[0].is<int>());
+    REQUIRE(1.5 == arr[0].as<double>());
+    REQUIRE(-2000.0 == arr[1].as<double>());
+    REQUIRE(std::string("[1.5,-2000]") == toJson(arr));
+  }
+
+  SECTION("Booleans and null") {
+    JsonObject& obj = jb.parseObject("{\"a\":true,\"b\":false,\"c\":null}");
+    REQUIRE(obj["a"].is<bool>());
+    REQUIRE(true == obj["a"].as<bool>());
+    REQUIRE(false == obj["b"].as<bool>());
+    REQUIRE(obj["c"].is<char*>());
+    REQUIRE(NULL == obj["c"].as<char*>());
+    REQUIRE(std::string("{\"a\":true,\"b\":false,\"c\":null}") == toJson(obj));
+  }
+
+  SECTION("Uses no room in the JsonBuffer") {
+    jb.parseArray("[1234567,true,null,1.25]");
+    REQUIRE(JSON_ARRAY_SIZE(4) == jb.size());
+  }
+
+  SECTION("Keeps the text of the other values") {
+    JsonArray& arr = jb.parseArray("[unquoted,12345678901234567890,1e]");
+    REQUIRE(std::string("unquoted") == arr[0].as<char*>());
+    REQUIRE(std::string("12345678901234567890") == arr[1].as<char*>());
+    REQUIRE(std::string("[unquoted,12345678901234567890,1e]") == toJson(arr));
+  }
+
+  SECTION("Very long value") {
+    std::string value(100, 'x');
+    JsonArray& arr = jb.parseArray("[" + value + "]");
+    REQUIRE(value == arr[0].as<char*>());
+  }
+
+  SECTION("Invalid input") {
+    REQUIRE_FALSE(jb.parseArray("[true false]").success());
+    REQUIRE_FALSE(jb.parseObject("{\"a\":1").success());
+  }
+
+  SECTION("measureJsonBufferSize() is exact") {
+    const char* inputs[] = {"[1,true,null]", "{\"a\":1.5,\"b\":[false,x]}",
+                            "[12345678901234567890,1e]", "42", "yes"};
+    for (size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); i++) {
+      INFO(inputs[i]);
+      REQUIRE(measureJsonBufferSize(inputs[i]) == sizeAfterParse(inputs[i]));
+    }
+  }
+}
@@ -4,7 +4,8 @@
 
 #include <ArduinoJson.h>
 #include <catch.hpp>
-#include <sstream>
+
+#include "../Helpers/SpyingAllocator.hpp"
 
 using namespace ArduinoJson::Internals;
 
@@ -14,19 +15,6 @@ static bool isAligned(void* ptr) {
   return (addr & mask) == 0;
 }
 
-std::stringstream allocatorLog;
-
-struct SpyingAllocator : DefaultAllocator {
-  void* allocate(size_t n) {
-    allocatorLog << "A" << (n - DynamicJsonBuffer::EmptyBlockSize);
-    return DefaultAllocator::allocate(n);
-  }
-  void deallocate(void* p) {
-    allocatorLog << "F";
-    return DefaultAllocator::deallocate(p);
-  }
-};
-
 TEST_CASE("DynamicJsonBuffer::alloc()") {
   SECTION("Returns different pointers") {
     DynamicJsonBuffer buffer;
@@ -36,17 +24,17 @@ TEST_CASE("DynamicJsonBuffer::alloc()") {
   }
 
   SECTION("Doubles allocation size when full") {
-    allocatorLog.str("");
+    allocatorLog().clear();
     {
       DynamicJsonBufferBase<SpyingAllocator> buffer(1);
       buffer.alloc(1);
       buffer.alloc(1);
     }
-    REQUIRE(allocatorLog.str() == "A1A2FF");
+    REQUIRE(allocatorLog().str() == "A1A2FF");
   }
 
   SECTION("Resets allocation size after clear()") {
-    allocatorLog.str("");
+    allocatorLog().clear();
     {
       DynamicJsonBufferBase<SpyingAllocator> buffer(1);
       buffer.alloc(1);
@@ -54,16 +42,16 @@ TEST_CASE("DynamicJsonBuffer::alloc()") {
       buffer.clear();
       buffer.alloc(1);
     }
-    REQUIRE(allocatorLog.str() == "A1A2FFA1F");
+    REQUIRE(allocatorLog().str() == "A1A2FFA1F");
   }
 
   SECTION("Makes a big allocation when needed") {
-    allocatorLog.str("");
+    allocatorLog().clear();
     {
       DynamicJsonBufferBase<SpyingAllocator> buffer(1);
       buffer.alloc(42);
     }
-    REQUIRE(allocatorLog.str() == "A42F");
+    REQUIRE(allocatorLog().str() == "A42F");
   }
 
   SECTION("Alignment") {
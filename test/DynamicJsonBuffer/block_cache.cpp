@@ -0,0 +1,87 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include "../Helpers/SpyingAllocator.hpp"
+
+using namespace ArduinoJson::Internals;
+
+typedef BlockCache<SpyingAllocator> Cache;
+typedef DynamicJsonBufferBase<Cache::Allocator> CachedJsonBuffer;
+
+TEST_CASE("BlockCache") {
+  allocatorLog().clear();
+
+  SECTION("Keeps freed blocks") {
+    Cache cache;
+    void* p = cache.allocate(100);
+    cache.deallocate(p);
+    REQUIRE(1 == cache.size());
+    REQUIRE(0 == allocatorLog().deallocations());
+  }
+
+  SECTION("Reuses blocks of the same size class") {
+    Cache cache;
+    void* p1 = cache.allocate(100);
+    cache.deallocate(p1);
+    void* p2 = cache.allocate(120);
+    REQUIRE(p1 == p2);
+    REQUIRE(1 == allocatorLog().allocations());
+    cache.deallocate(p2);
+  }
+
+  SECTION("Doesn't mix size classes") {
+    Cache cache;
+    void* p1 = cache.allocate(100);
+    cache.deallocate(p1);
+    void* p2 = cache.allocate(1000);
+    REQUIRE(p1 != p2);
+    REQUIRE(2 == allocatorLog().allocations());
+    cache.deallocate(p2);
+  }
+
+  SECTION("Returns extra blocks to the upstream allocator") {
+    Cache cache(1);
+    void* p1 = cache.allocate(100);
+    void* p2 = cache.allocate(100);
+    cache.deallocate(p1);
+    cache.deallocate(p2);
+    REQUIRE(1 == cache.size());
+    REQUIRE(1 == allocatorLog().deallocations());
+  }
+
+  SECTION("Bypasses the cache for huge blocks") {
+    Cache cache;
+    void* p = cache.allocate(10000000);
+    cache.deallocate(p);
+    REQUIRE(0 == cache.size());
+    REQUIRE(1 == allocatorLog().deallocations());
+  }
+
+  SECTION("Frees the blocks when destroyed") {
+    {
+      Cache cache;
+      cache.deallocate(cache.allocate(100));
+      cache.deallocate(cache.allocate(1000));
+    }
+    REQUIRE(2 == allocatorLog().deallocations());
+  }
+
+  SECTION("Recycles the blocks of DynamicJsonBuffer") {
+    Cache cache;
+    char json[] = "{\"hello\":\"world\",\"list\":[1,2,3,4,5,6,7,8,9]}";
+
+    for (int i = 0; i < 10; i++) {
+      CachedJsonBuffer buffer(16, cache.allocator());
+      JsonObject& root = buffer.parseObject(static_cast<const char*>(json));
+      REQUIRE(root.success());
+      if (i == 0) allocatorLog().clear();
+    }
+
+    REQUIRE(0 == allocatorLog().allocations());
+    REQUIRE(0 == allocatorLog().deallocations());
+  }
+}
@@ -0,0 +1,49 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include "../Helpers/SpyingAllocator.hpp"
+#include <string>
+
+using namespace ArduinoJson::Internals;
+
+TEST_CASE("DynamicJsonBuffer::compact()") {
+  DynamicJsonBuffer source(16);
+  JsonObject& original = source.createObject();
+  for (int i = 0; i < 20; i++) {
+    JsonObject& item = original.createNestedObject(std::string(1, 'a' + i));
+    item["name"] = std::string("item");
+    item.createNestedArray("values").add(i);
+  }
+  allocatorLog().clear();
+
+  SECTION("Copies the document in a single block") {
+    DynamicJsonBufferBase<SpyingAllocator> target(16);
+    JsonVariant copy = target.compact(original);
+    REQUIRE(copy.success());
+    REQUIRE(allocatorLog().allocations() == 1);
+
+    std::string expected, actual;
+    original.printTo(expected);
+    copy.printTo(actual);
+    REQUIRE(actual == expected);
+  }
+
+  SECTION("The block fits exactly") {
+    DynamicJsonBufferBase<SpyingAllocator> target(16);
+    target.compact(original);
+    REQUIRE(allocatorLog().allocations() == 1);
+    REQUIRE(target.reserve(1));
+    REQUIRE(allocatorLog().allocations() == 2);
+  }
+
+  SECTION("Uses the current block if it's big enough") {
+    DynamicJsonBufferBase<SpyingAllocator> target(8192);
+    target.alloc(1);
+    target.compact(original);
+    REQUIRE(allocatorLog().allocations() == 1);
+  }
+}
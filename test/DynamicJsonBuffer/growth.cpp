@@ -0,0 +1,118 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include "../Helpers/SpyingAllocator.hpp"
+
+using namespace ArduinoJson::Internals;
+
+typedef DynamicJsonBufferBase<SpyingAllocator> SpiedBuffer;
+
+TEST_CASE("DynamicJsonBuffer::setGrowthPolicy()") {
+  SpiedBuffer::GrowthPolicy policy;
+  allocatorLog().clear();
+
+  SECTION("Doubles by default") {
+    {
+      SpiedBuffer buffer(8);
+      for (int i = 0; i < 4; i++) buffer.alloc(8);
+    }
+    REQUIRE(allocatorLog().str() == "A8A16A32FFF");
+  }
+
+  SECTION("Factor") {
+    policy.factor = 4;
+    {
+      SpiedBuffer buffer(8);
+      buffer.setGrowthPolicy(policy);
+      for (int i = 0; i < 4; i++) buffer.alloc(8);
+    }
+    REQUIRE(allocatorLog().str() == "A8A32FF");
+  }
+
+  SECTION("Constant block size") {
+    policy.factor = 1;
+    {
+      SpiedBuffer buffer(8);
+      buffer.setGrowthPolicy(policy);
+      for (int i = 0; i < 3; i++) buffer.alloc(8);
+    }
+    REQUIRE(allocatorLog().str() == "A8A8A8FFF");
+  }
+
+  SECTION("MaxBlockCapacity") {
+    policy.maxBlockCapacity = 16;
+    {
+      SpiedBuffer buffer(8);
+      buffer.setGrowthPolicy(policy);
+      for (int i = 0; i < 5; i++) buffer.alloc(8);
+    }
+    REQUIRE(allocatorLog().str() == "A8A16A16FFF");
+  }
+
+  SECTION("MaxBlockCapacity doesn't limit a single allocation") {
+    policy.maxBlockCapacity = 16;
+    {
+      SpiedBuffer buffer(8);
+      buffer.setGrowthPolicy(policy);
+      REQUIRE(buffer.alloc(40) != NULL);
+    }
+    REQUIRE(allocatorLog().str() == "A40F");
+  }
+
+  SECTION("Direct allocation") {
+    policy.directAllocationThreshold = 32;
+    {
+      SpiedBuffer buffer(16);
+      buffer.setGrowthPolicy(policy);
+      buffer.alloc(8);
+      void* big = buffer.alloc(1000);
+      void* small = buffer.alloc(8);
+      REQUIRE(big != NULL);
+      REQUIRE(small != NULL);
+      REQUIRE(buffer.size() == 1016);
+      buffer.alloc(8);  // the head is full now
+    }
+    // the head keeps serving the small allocations and the sequence goes on
+    REQUIRE(allocatorLog().str() == "A16A1000A32FFF");
+  }
+
+  SECTION("Direct allocation in an empty buffer") {
+    policy.directAllocationThreshold = 32;
+    {
+      SpiedBuffer buffer(16);
+      buffer.setGrowthPolicy(policy);
+      buffer.alloc(1000);
+      buffer.alloc(8);
+    }
+    REQUIRE(allocatorLog().str() == "A1000A16FF");
+  }
+
+  SECTION("clear() restores the initial capacity") {
+    policy.directAllocationThreshold = 32;
+    {
+      SpiedBuffer buffer(16);
+      buffer.setGrowthPolicy(policy);
+      buffer.alloc(8);
+      buffer.alloc(1000);
+      buffer.clear();
+      buffer.alloc(8);
+    }
+    REQUIRE(allocatorLog().str() == "A16A1000FFA16F");
+  }
+
+  SECTION("recycle() doesn't keep more than maxBlockCapacity") {
+    policy.maxBlockCapacity = 64;
+    {
+      SpiedBuffer buffer(16);
+      buffer.setGrowthPolicy(policy);
+      buffer.alloc(1000);
+      buffer.alloc(8);
+      buffer.recycle();
+    }
+    REQUIRE(allocatorLog().str() == "A1000A32FFA64F");
+  }
+}
@@ -0,0 +1,81 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include "../Helpers/SpyingAllocator.hpp"
+
+using namespace ArduinoJson::Internals;
+
+typedef HybridJsonBuffer<64, SpyingAllocator> Buffer;
+
+static bool isInside(const void* p, const void* begin, size_t size) {
+  const char* c = static_cast<const char*>(p);
+  const char* b = static_cast<const char*>(begin);
+  return c >= b && c < b + size;
+}
+
+TEST_CASE("HybridJsonBuffer") {
+  allocatorLog().clear();
+
+  SECTION("Uses the inline pool first") {
+    Buffer buffer;
+    void* p = buffer.alloc(64);
+    REQUIRE(p != NULL);
+    REQUIRE(isInside(p, &buffer, sizeof(buffer)));
+    REQUIRE(allocatorLog().allocations() == 0);
+  }
+
+  SECTION("Spills to the heap when the inline pool is full") {
+    Buffer buffer;
+    buffer.alloc(64);
+    void* p = buffer.alloc(8);
+    REQUIRE(p != NULL);
+    REQUIRE_FALSE(isInside(p, &buffer, sizeof(buffer)));
+    REQUIRE(allocatorLog().allocations() == 1);
+    REQUIRE(buffer.size() == 72);
+  }
+
+  SECTION("Parses a document bigger than the inline pool") {
+    Buffer buffer;
+    char json[] = "[1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16]";
+    JsonArray& arr = buffer.parseArray(json);
+    REQUIRE(arr.success());
+    REQUIRE(arr.size() == 16);
+    REQUIRE(arr[15] == 16);
+    REQUIRE(allocatorLog().allocations() > 0);
+  }
+
+  SECTION("Keeps a string that outgrows the inline pool") {
+    Buffer buffer;
+    buffer.alloc(32);
+    Buffer::String str = buffer.startString();
+    for (int i = 0; i < 100; i++) str.append('x');
+    REQUIRE(std::string(str.c_str()) == std::string(100, 'x'));
+  }
+
+  SECTION("clear() goes back to the inline pool") {
+    Buffer buffer;
+    buffer.alloc(64);
+    buffer.alloc(64);
+    buffer.clear();
+    REQUIRE(buffer.size() == 0);
+    void* p = buffer.alloc(8);
+    REQUIRE(isInside(p, &buffer, sizeof(buffer)));
+    REQUIRE(allocatorLog().allocations() == 1);
+  }
+
+  SECTION("recycle() keeps the heap memory") {
+    Buffer buffer;
+    buffer.alloc(64);
+    buffer.alloc(64);
+    buffer.recycle();
+    REQUIRE(buffer.size() == 0);
+    allocatorLog().clear();
+    buffer.alloc(64);
+    buffer.alloc(64);
+    REQUIRE(allocatorLog().allocations() == 0);
+  }
+}
@@ -0,0 +1,94 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include "../Helpers/SpyingAllocator.hpp"
+
+using namespace ArduinoJson::Internals;
+
+typedef DynamicJsonBufferBase<SpyingAllocator> Buffer;
+
+TEST_CASE("DynamicJsonBuffer::release()") {
+  allocatorLog().clear();
+
+  SECTION("Goes back to the size of the mark") {
+    Buffer buffer(64);
+    buffer.alloc(3);
+    Buffer::Mark mark = buffer.mark();
+    size_t size = buffer.size();
+    buffer.alloc(8);
+    buffer.release(mark);
+    REQUIRE(buffer.size() == size);
+    REQUIRE(allocatorLog().blocks() == 1);
+  }
+
+  SECTION("Frees the blocks allocated after the mark") {
+    Buffer buffer(16);
+    buffer.alloc(8);
+    Buffer::Mark mark = buffer.mark();
+    for (int i = 0; i < 10; i++) buffer.alloc(16);
+    REQUIRE(allocatorLog().blocks() > 1);
+    buffer.release(mark);
+    REQUIRE(allocatorLog().blocks() == 1);
+    REQUIRE(buffer.size() == 8);
+  }
+
+  SECTION("Mark in an empty buffer") {
+    Buffer buffer(16);
+    Buffer::Mark mark = buffer.mark();
+    buffer.alloc(8);
+    buffer.alloc(32);
+    buffer.release(mark);
+    REQUIRE(allocatorLog().blocks() == 0);
+    REQUIRE(buffer.size() == 0);
+  }
+
+  SECTION("Frees the direct blocks allocated after the mark") {
+    Buffer buffer(64);
+    Buffer::GrowthPolicy policy;
+    policy.directAllocationThreshold = 32;
+    buffer.setGrowthPolicy(policy);
+    buffer.alloc(8);
+    Buffer::Mark mark = buffer.mark();
+    buffer.alloc(100);
+    buffer.alloc(8);
+    REQUIRE(allocatorLog().blocks() == 2);
+    buffer.release(mark);
+    REQUIRE(allocatorLog().blocks() == 1);
+    REQUIRE(buffer.size() == 8);
+  }
+
+  SECTION("Keeps the data allocated before the mark") {
+    Buffer buffer(16);
+    JsonObject& root = buffer.createObject();
+    root["status"] = "ok";
+    size_t size = buffer.size();
+
+    Buffer::Mark mark = buffer.mark();
+    JsonArray& items = buffer.createArray();
+    for (int i = 0; i < 10; i++) items.add(i);
+    buffer.release(mark);
+
+    REQUIRE(buffer.size() == size);
+    REQUIRE(root["status"] == std::string("ok"));
+    root["value"] = 42;
+    REQUIRE(root["value"] == 42);
+  }
+
+  SECTION("Mark in an empty recycled block") {
+    Buffer buffer(16);
+    buffer.alloc(16);
+    buffer.alloc(16);
+    buffer.recycle();
+    Buffer::Mark mark = buffer.mark();
+    Buffer::String str = buffer.startString();
+    for (int i = 0; i < 40; i++) str.append('x');
+    str.c_str();
+    buffer.release(mark);
+    REQUIRE(buffer.size() == 0);
+    REQUIRE(allocatorLog().blocks() == 0);
+  }
+}
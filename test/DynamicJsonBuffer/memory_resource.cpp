@@ -0,0 +1,85 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+#include <stdlib.h>
+#include <new>
+
+using namespace ArduinoJson::Internals;
+
+// Mimics std::pmr::memory_resource
+class FakeMemoryResource {
+ public:
+  FakeMemoryResource() : allocated(0), limit(size_t(-1)) {}
+
+  void* allocate(size_t bytes, size_t alignment) {
+    REQUIRE(alignment >= sizeof(void*));
+    if (allocated + bytes > limit) throw std::bad_alloc();
+    allocated += bytes;
+    return malloc(bytes);
+  }
+
+  void deallocate(void* p, size_t bytes, size_t) {
+    allocated -= bytes;
+    free(p);
+  }
+
+  size_t allocated;
+  size_t limit;
+};
+
+typedef MemoryResourceAllocator<FakeMemoryResource> ResourceAllocator;
+
+TEST_CASE("MemoryResourceAllocator") {
+  FakeMemoryResource resource;
+
+  SECTION("Gives the size back to deallocate()") {
+    ResourceAllocator allocator(&resource);
+    void* p = allocator.allocate(42);
+    REQUIRE(resource.allocated >= 42);
+    allocator.deallocate(p);
+    REQUIRE(0 == resource.allocated);
+  }
+
+  SECTION("Returns NULL when the resource throws") {
+    ResourceAllocator allocator(&resource);
+    resource.limit = 0;
+    REQUIRE(0 == allocator.allocate(42));
+  }
+
+  SECTION("Fails to parse when the resource throws") {
+    resource.limit = 256;
+    {
+      DynamicJsonBufferBase<ResourceAllocator> buffer(
+          16, ResourceAllocator(&resource));
+      std::string json = "[";
+      for (int i = 0; i < 100; i++) json += "\"hello\",";
+      json += "42]";
+      REQUIRE_FALSE(buffer.parseArray(json).success());
+    }
+    REQUIRE(0 == resource.allocated);
+  }
+
+  SECTION("Works with DynamicJsonBuffer") {
+    {
+      DynamicJsonBufferBase<ResourceAllocator> buffer(
+          16, ResourceAllocator(&resource));
+      JsonArray& array = buffer.parseArray("[\"hello\",\"world\",42]");
+      REQUIRE(array.success());
+      REQUIRE(resource.allocated > 0);
+    }
+    REQUIRE(0 == resource.allocated);
+  }
+
+  SECTION("Works as the upstream of BlockCache") {
+    {
+      BlockCache<ResourceAllocator> cache(8, ResourceAllocator(&resource));
+      DynamicJsonBufferBase<BlockCache<ResourceAllocator>::Allocator> buffer(
+          16, cache.allocator());
+      REQUIRE(buffer.parseArray("[1,2,3]").success());
+    }
+    REQUIRE(0 == resource.allocated);
+  }
+}
@@ -0,0 +1,233 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include "../Helpers/SpyingAllocator.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <pthread.h>
+#define HAS_PTHREAD 1
+#endif
+
+using namespace ArduinoJson::Internals;
+
+struct SpyingMutex {
+  static int locks, unlocks;
+  void lock() {
+    locks++;
+  }
+  void unlock() {
+    unlocks++;
+  }
+};
+int SpyingMutex::locks;
+int SpyingMutex::unlocks;
+
+typedef DynamicJsonBufferPoolBase<SpyingAllocator> Pool;
+
+#ifdef HAS_PTHREAD
+struct PthreadMutex {
+  PthreadMutex() {
+    pthread_mutex_init(&mutex, NULL);
+  }
+  ~PthreadMutex() {
+    pthread_mutex_destroy(&mutex);
+  }
+  void lock() {
+    pthread_mutex_lock(&mutex);
+  }
+  void unlock() {
+    pthread_mutex_unlock(&mutex);
+  }
+  pthread_mutex_t mutex;
+};
+
+// The logs are shared by the threads
+static PthreadMutex logMutex;
+
+struct LockedSpyingAllocator : SpyingAllocator {
+  explicit LockedSpyingAllocator(AllocatorLog* log = &allocatorLog())
+      : SpyingAllocator(log) {}
+  void* allocate(size_t n) {
+    Lock<PthreadMutex> lock(logMutex);
+    return SpyingAllocator::allocate(n);
+  }
+  void deallocate(void* p) {
+    Lock<PthreadMutex> lock(logMutex);
+    SpyingAllocator::deallocate(p);
+  }
+};
+
+typedef DynamicJsonBufferPoolBase<LockedSpyingAllocator, PthreadMutex>
+    ThreadPool;
+
+struct Worker {
+  ThreadPool* global;
+  AllocatorLog log;
+  int failures;
+};
+
+static void* work(void* arg) {
+  Worker& worker = *static_cast<Worker*>(arg);
+  {
+    ThreadPool local(1, 64, worker.global, LockedSpyingAllocator(&worker.log));
+    for (int i = 0; i < 1000; i++) {
+      ThreadPool::Lease lease1(local);
+      ThreadPool::Lease lease2(local);
+      ThreadPool::Lease lease3(local);
+      JsonArray& array = lease2->parseArray("[1,{\"a\":[2,3]},\"four\"]");
+      if (!lease1.success() || !lease3.success() || array.size() != 3)
+        worker.failures++;
+    }
+  }
+  return NULL;
+}
+#endif
+
+TEST_CASE("DynamicJsonBufferPool") {
+  allocatorLog().clear();
+
+  SECTION("Lease gives an empty buffer") {
+    DynamicJsonBufferPool pool;
+    DynamicJsonBufferPool::Lease lease(pool);
+    REQUIRE(lease.success());
+    REQUIRE(0 == lease->size());
+  }
+
+  SECTION("Buffer goes back to the pool") {
+    Pool pool;
+    REQUIRE(0 == pool.size());
+    { Pool::Lease lease(pool); }
+    REQUIRE(1 == pool.size());
+    {
+      Pool::Lease lease(pool);
+      REQUIRE(0 == pool.size());
+    }
+    REQUIRE(1 == pool.size());
+  }
+
+  SECTION("Returned buffers are cleared") {
+    Pool pool;
+    {
+      Pool::Lease lease(pool);
+      lease->alloc(42);
+    }
+    Pool::Lease lease(pool);
+    REQUIRE(0 == (*lease).size());
+  }
+
+  SECTION("Doesn't allocate in steady state") {
+    Pool pool(4, 16);
+    char json[] = "[\"hello\",\"world\",{\"key\":[1,2,3]}]";
+    for (int i = 0; i < 10; i++) {
+      {
+        Pool::Lease lease(pool);
+        JsonArray& array = lease->parseArray(static_cast<const char*>(json));
+        REQUIRE(array.success());
+        REQUIRE(3 == array.size());
+      }
+      if (i == 0) allocatorLog().clear();
+    }
+    REQUIRE(0 == allocatorLog().allocations());
+  }
+
+  SECTION("Destroys extra buffers") {
+    Pool pool(1);
+    {
+      Pool::Lease lease1(pool);
+      Pool::Lease lease2(pool);
+    }
+    REQUIRE(1 == pool.size());
+  }
+
+  SECTION("Gives extra buffers to the overflow pool") {
+    Pool global(2);
+    Pool local(1, 256, &global);
+    {
+      Pool::Lease lease1(local);
+      Pool::Lease lease2(local);
+      Pool::Lease lease3(local);
+    }
+    REQUIRE(1 == local.size());
+    REQUIRE(2 == global.size());
+  }
+
+  SECTION("Takes buffers from the overflow pool") {
+    Pool global(2);
+    { Pool::Lease lease(global); }
+    Pool local(1, 256, &global);
+    allocatorLog().clear();
+    { Pool::Lease lease(local); }
+    REQUIRE(0 == allocatorLog().allocations());
+    REQUIRE(0 == global.size());
+    REQUIRE(1 == local.size());
+  }
+
+  SECTION("Uses the mutex") {
+    SpyingMutex::locks = SpyingMutex::unlocks = 0;
+    {
+      DynamicJsonBufferPoolBase<DefaultAllocator, SpyingMutex> pool;
+      DynamicJsonBufferPoolBase<DefaultAllocator, SpyingMutex>::Lease lease(
+          pool);
+    }
+    REQUIRE(2 == SpyingMutex::locks);
+    REQUIRE(2 == SpyingMutex::unlocks);
+  }
+
+  SECTION("Gives the key table to the buffers") {
+    JsonKeyTable table;
+    DynamicJsonBufferPool pool;
+    pool.setKeyTable(&table);
+
+    DynamicJsonBufferPool::Lease lease(pool);
+    JsonObject& obj = lease->parseObject("{\"hello\":1}");
+
+    REQUIRE(obj.begin()->key == table.intern("hello"));
+  }
+
+  SECTION("Frees the buffers with the allocator that created them") {
+    AllocatorLog globalLog;
+    AllocatorLog localLog;
+    {
+      Pool global(0, 256, NULL, SpyingAllocator(&globalLog));
+      Pool local(1, 256, &global, SpyingAllocator(&localLog));
+      {
+        Pool::Lease lease1(local);
+        Pool::Lease lease2(local);
+        lease1->alloc(42);
+        lease2->alloc(42);
+      }
+      REQUIRE(1 == local.size());
+      REQUIRE(0 == global.size());
+    }
+    REQUIRE(0 == localLog.blocks());
+    REQUIRE(0 == globalLog.blocks());
+  }
+
+#ifdef HAS_PTHREAD
+  SECTION("Shares the overflow pool between threads") {
+    const int threadCount = 4;
+    AllocatorLog globalLog;
+    Worker workers[threadCount];
+    {
+      ThreadPool global(2, 64, NULL, LockedSpyingAllocator(&globalLog));
+      pthread_t threads[threadCount];
+      for (int i = 0; i < threadCount; i++) {
+        workers[i].global = &global;
+        workers[i].failures = 0;
+        REQUIRE(0 == pthread_create(&threads[i], NULL, work, &workers[i]));
+      }
+      for (int i = 0; i < threadCount; i++) pthread_join(threads[i], NULL);
+      REQUIRE(global.size() <= 2);
+    }
+    REQUIRE(0 == globalLog.blocks());
+    for (int i = 0; i < threadCount; i++) {
+      REQUIRE(0 == workers[i].failures);
+      REQUIRE(0 == workers[i].log.blocks());
+    }
+  }
+#endif
+}
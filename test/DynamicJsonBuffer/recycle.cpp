@@ -0,0 +1,68 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include "../Helpers/SpyingAllocator.hpp"
+#include <sstream>
+
+using namespace ArduinoJson::Internals;
+
+TEST_CASE("DynamicJsonBuffer::recycle()") {
+  const size_t word = sizeof(void*);
+  allocatorLog().clear();
+
+  SECTION("Does nothing when empty") {
+    {
+      DynamicJsonBufferBase<SpyingAllocator> buffer;
+      buffer.recycle();
+    }
+    REQUIRE(allocatorLog().str() == "");
+  }
+
+  SECTION("Keeps a single block") {
+    {
+      DynamicJsonBufferBase<SpyingAllocator> buffer(word);
+      buffer.alloc(1);
+      buffer.recycle();
+      REQUIRE(0 == buffer.size());
+      buffer.alloc(1);
+      buffer.recycle();
+    }
+    std::stringstream expected;
+    expected << "A" << word << "F";
+    REQUIRE(allocatorLog().str() == expected.str());
+  }
+
+  SECTION("Merges blocks") {
+    {
+      DynamicJsonBufferBase<SpyingAllocator> buffer(word);
+      buffer.alloc(word);
+      buffer.alloc(word);
+      buffer.recycle();
+      buffer.alloc(word);
+      buffer.alloc(word);
+    }
+    std::stringstream expected;
+    expected << "A" << word << "A" << 2 * word << "FFA" << 2 * word << "F";
+    REQUIRE(allocatorLog().str() == expected.str());
+  }
+
+  SECTION("Doesn't allocate in steady state") {
+    DynamicJsonBufferBase<SpyingAllocator> buffer(16);
+    const char json[] = "{\"sensor\":\"gps\",\"time\":1351824120,"
+                        "\"data\":[48.756080,2.302038],"
+                        "\"nested\":{\"key\":\"value\",\"list\":[1,2,3]}}";
+
+    for (int i = 0; i < 10; i++) {
+      allocatorLog().clear();
+      JsonObject& root = buffer.parseObject(json);
+      REQUIRE(root.success());
+      REQUIRE(root["nested"]["key"] == std::string("value"));
+      buffer.recycle();
+      if (i > 0) REQUIRE(allocatorLog().str() == "");
+    }
+  }
+}
@@ -44,4 +44,38 @@ TEST_CASE("DynamicJsonBuffer::startString()") {
     str.c_str();
     REQUIRE(2 == jsonBuffer.size());
   }
+
+  SECTION("DoesntLeaveACopyBehind") {
+    DynamicJsonBuffer jsonBuffer(8);
+    jsonBuffer.alloc(1);
+
+    DynamicJsonBuffer::String str = jsonBuffer.startString();
+    for (int i = 0; i < 100; i++) str.append('x');
+    str.c_str();
+
+    REQUIRE(1 + 100 + 1 == jsonBuffer.size());
+  }
+
+  SECTION("AppendsSeveralCharacters") {
+    DynamicJsonBuffer jsonBuffer(6);
+
+    DynamicJsonBuffer::String str = jsonBuffer.startString();
+    str.append("hel", 3);
+    str.append("lo", 2);
+
+    REQUIRE(std::string("hello") == str.c_str());
+    REQUIRE(6 == jsonBuffer.size());
+  }
+
+  SECTION("MovesToANewBlockWhenAppendingSeveralCharacters") {
+    DynamicJsonBuffer jsonBuffer(8);
+    jsonBuffer.alloc(1);
+
+    DynamicJsonBuffer::String str = jsonBuffer.startString();
+    str.append("hello", 5);
+    str.append(" world", 6);
+
+    REQUIRE(std::string("hello world") == str.c_str());
+    REQUIRE(1 + 11 + 1 == jsonBuffer.size());
+  }
 }
@@ -0,0 +1,80 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#pragma once
+
+#include <ArduinoJson.h>
+#include <sstream>
+#include <string>
+
+// What the SpyingAllocators did
+class AllocatorLog {
+ public:
+  AllocatorLog() : _allocations(0), _deallocations(0) {}
+
+  void clear() {
+    _text.str("");
+    _allocations = 0;
+    _deallocations = 0;
+  }
+
+  void allocated(size_t n) {
+    _text << "A" << (n - ArduinoJson::DynamicJsonBuffer::EmptyBlockSize);
+    _allocations++;
+  }
+
+  void deallocated() {
+    _text << "F";
+    _deallocations++;
+  }
+
+  // Gets "A" and the capacity of the block for each allocation, and "F" for
+  // each deallocation
+  std::string str() const {
+    return _text.str();
+  }
+
+  int allocations() const {
+    return _allocations;
+  }
+
+  int deallocations() const {
+    return _deallocations;
+  }
+
+  // Gets the number of blocks not freed yet
+  int blocks() const {
+    return _allocations - _deallocations;
+  }
+
+ private:
+  std::stringstream _text;
+  int _allocations;
+  int _deallocations;
+};
+
+// The log of the SpyingAllocators created without one
+inline AllocatorLog& allocatorLog() {
+  static AllocatorLog log;
+  return log;
+}
+
+// An allocator that writes what it does in an AllocatorLog
+class SpyingAllocator : public ArduinoJson::Internals::DefaultAllocator {
+ public:
+  explicit SpyingAllocator(AllocatorLog* log = &allocatorLog()) : _log(log) {}
+
+  void* allocate(size_t n) {
+    _log->allocated(n);
+    return DefaultAllocator::allocate(n);
+  }
+
+  void deallocate(void* p) {
+    _log->deallocated();
+    DefaultAllocator::deallocate(p);
+  }
+
+ private:
+  AllocatorLog* _log;
+};
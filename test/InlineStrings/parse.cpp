@@ -0,0 +1,84 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#define ARDUINOJSON_ENABLE_INLINE_STRINGS 1
+#include <ArduinoJson.h>
+#include <catch.hpp>
+#include <string>
+
+using namespace ArduinoJson::Internals;
+
+static std::string toJson(const JsonVariant& variant) {
+  std::string json;
+  variant.printTo(json);
+  return json;
+}
+
+TEST_CASE("Inline strings") {
+  DynamicJsonBuffer jb;
+  const std::string maxLength(InlineStringSize - 1, 'x');
+  const std::string tooLong(InlineStringSize, 'y');
+
+  SECTION("Short string") {
+    JsonObject& obj = jb.parseObject("{\"state\":\"on\"}");
+    const char* state = obj["state"];
+    REQUIRE(std::string("on") == state);
+    REQUIRE(obj["state"].is<const char*>());
+    REQUIRE(obj["state"] == "on");
+    REQUIRE(obj["state"] != "off");
+    REQUIRE(std::string("{\"state\":\"on\"}") == toJson(obj));
+  }
+
+  SECTION("Uses no room in the JsonBuffer") {
+    std::string json = "[\"\",\"" + maxLength + "\"]";
+    JsonArray& arr = jb.parseArray(json);
+    REQUIRE(JSON_ARRAY_SIZE(2) == jb.size());
+    REQUIRE(std::string("") == arr[0].as<char*>());
+    REQUIRE(maxLength == arr[1].as<char*>());
+  }
+
+  SECTION("Long string") {
+    std::string json = "[\"" + tooLong + "\"]";
+    JsonArray& arr = jb.parseArray(json);
+    REQUIRE(tooLong == arr[0].as<char*>());
+    REQUIRE(JSON_ARRAY_SIZE(1) + tooLong.size() < jb.size());
+  }
+
+  SECTION("Escaped characters") {
+    JsonArray& arr = jb.parseArray("[\"a\\nb\"]");
+    REQUIRE(std::string("a\nb") == arr[0].as<char*>());
+    REQUIRE(std::string("[\"a\\nb\"]") == toJson(arr));
+  }
+
+  SECTION("Numbers in a string") {
+    JsonArray& arr = jb.parseArray("[\"42\",\"1.5\"]");
+    REQUIRE(42 == arr[0].as<int>());
+    REQUIRE(1.5 == arr[1].as<double>());
+  }
+
+  SECTION("Copy") {
+    JsonArray& arr = jb.parseArray("[\"ok\"]");
+    JsonVariant copy = arr[0];
+    REQUIRE(std::string("ok") == copy.as<char*>());
+
+    DynamicJsonBuffer other;
+    JsonVariant clone = other.clone(arr);
+    REQUIRE(std::string("[\"ok\"]") == toJson(clone));
+    REQUIRE(JSON_ARRAY_SIZE(1) == other.size());
+  }
+
+  SECTION("In place") {
+    char json[] = "[\"ok\",\"a longer string\"]";
+    JsonArray& arr = jb.parseArray(json);
+    REQUIRE(std::string("ok") == arr[0].as<char*>());
+    REQUIRE(std::string("a longer string") == arr[1].as<char*>());
+  }
+
+  SECTION("measureJsonBufferSize()") {
+    std::string json = "{\"a\":\"" + maxLength + "\",\"b\":[\"" + tooLong +
+                       "\",\"c\",x]}";
+    jb.parse(json);
+    REQUIRE(measureJsonBufferSize(json) == jb.size());
+  }
+}
@@ -0,0 +1,118 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+#include <stdio.h>
+#include <string>
+
+TEST_CASE("JsonArray index") {
+  DynamicJsonBuffer jb;
+  JsonArray& array = jb.createArray();
+  for (int i = 0; i < 100; i++) array.add(i);
+
+  SECTION("get()") {
+    for (int i = 0; i < 100; i++) REQUIRE(array.get<int>(i) == i);
+    REQUIRE(array.get<int>(100) == 0);
+  }
+
+  SECTION("set()") {
+    REQUIRE(array.set(70, 700));
+    REQUIRE(array[70] == 700);
+    REQUIRE_FALSE(array.set(100, 1));
+  }
+
+  SECTION("is()") {
+    REQUIRE(array.is<int>(99));
+    REQUIRE_FALSE(array.is<int>(100));
+  }
+
+  SECTION("add() after indexed access") {
+    REQUIRE(array[99] == 99);
+    for (int i = 100; i < 300; i++) array.add(i);
+    for (int i = 0; i < 300; i++) REQUIRE(array[i] == i);
+  }
+
+  SECTION("remove() after indexed access") {
+    REQUIRE(array[99] == 99);
+    array.remove(50);
+    array.remove(array.begin());
+    array.remove(97);
+    REQUIRE(array.size() == 97);
+    REQUIRE(array[0] == 1);
+    REQUIRE(array[48] == 49);
+    REQUIRE(array[49] == 51);
+    REQUIRE(array[96] == 98);
+    REQUIRE_FALSE(array[97].success());
+    array.add(100);
+    REQUIRE(array[97] == 100);
+  }
+
+#if ARDUINOJSON_ARRAY_INDEX_THRESHOLD
+  SECTION("The index is allocated once, by a non-const access") {
+    StaticJsonBuffer<JSON_ARRAY_SIZE(40) + 128 * sizeof(void*)> sb;
+    JsonArray& arr = sb.createArray();
+    for (int i = 0; i < 40; i++) arr.add(i);
+    size_t size = sb.size();
+    const JsonArray& carr = arr;
+    REQUIRE(carr[39] == 39);
+    REQUIRE(carr.get<int>(39) == 39);
+    REQUIRE(sb.size() == size);
+    REQUIRE(arr[39] == 39);
+    REQUIRE(sb.size() > size);
+    size = sb.size();
+    REQUIRE(arr.get<int>(20) == 20);
+    REQUIRE(arr.set(20, 20));
+    REQUIRE(sb.size() == size);
+  }
+
+  SECTION("Reads of a parsed array build the index") {
+    // strings, so that the array isn't packed
+    std::string json = "[\"0\"";
+    for (int i = 1; i < 1000; i++) {
+      char value[16];
+      sprintf(value, ",\"%d\"", i);
+      json += value;
+    }
+    json += "]";
+    DynamicJsonBuffer db;
+    JsonArray& arr = db.parseArray(json);
+    size_t size = db.size();
+    REQUIRE(arr[999].as<int>() == 999);
+    size_t indexed = db.size();
+    REQUIRE(indexed >= size + 1000 * sizeof(void*));
+    for (int i = 0; i < 1000; i++) REQUIRE(arr.get<int>(i) == i);
+    REQUIRE(arr.is<const char*>(500));
+    REQUIRE(db.size() == indexed);
+  }
+
+  SECTION("Const accesses use the index without completing it") {
+    REQUIRE(array.buildIndex());
+    for (int i = 100; i < 120; i++) array.add(i);
+    const JsonArray& carr = array;
+    for (int i = 0; i < 120; i++) REQUIRE(carr.get<int>(i) == i);
+  }
+
+  SECTION("Grows without copying the index") {
+    StaticJsonBuffer<JSON_ARRAY_SIZE(80) + 128 * sizeof(void*)> sb;
+    JsonArray& arr = sb.createArray();
+    for (int i = 0; i < 40; i++) arr.add(i);
+    REQUIRE(arr.buildIndex());
+    size_t indexSize = sb.size() - JSON_ARRAY_SIZE(40);
+    for (int i = 40; i < 80; i++) arr.add(i);
+    REQUIRE(arr.buildIndex());
+    // the second segment is twice as big as the first one
+    REQUIRE(sb.size() - JSON_ARRAY_SIZE(80) < 4 * indexSize);
+    for (int i = 0; i < 80; i++) REQUIRE(arr[i] == i);
+  }
+
+  SECTION("Falls back to a linear search when the buffer is full") {
+    StaticJsonBuffer<JSON_ARRAY_SIZE(40)> sb;
+    JsonArray& arr = sb.createArray();
+    for (int i = 0; i < 40; i++) arr.add(i);
+    REQUIRE(arr[39] == 39);
+    REQUIRE(arr.get<int>(30) == 30);
+  }
+#endif
+}
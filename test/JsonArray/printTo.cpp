@@ -119,14 +119,18 @@ TEST_CASE("JsonArray::printTo()") {
   }
 
   SECTION("OneEmptyNestedArray") {
-    array.createNestedArray();
+    StaticJsonBuffer<JSON_ARRAY_SIZE(1) + JSON_ARRAY_SIZE(0)> nestedBuffer;
+    JsonArray &root = nestedBuffer.createArray();
+    root.createNestedArray();
 
-    check(array, "[[]]");
+    check(root, "[[]]");
   }
 
   SECTION("OneEmptyNestedHash") {
-    array.createNestedObject();
+    StaticJsonBuffer<JSON_ARRAY_SIZE(1) + JSON_OBJECT_SIZE(0)> nestedBuffer;
+    JsonArray &root = nestedBuffer.createArray();
+    root.createNestedObject();
 
-    check(array, "[{}]");
+    check(root, "[{}]");
   }
 }
@@ -0,0 +1,59 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+#include <string>
+
+static std::string serialize(const JsonVariant& variant) {
+  std::string json;
+  variant.printTo(json);
+  return json;
+}
+
+TEST_CASE("JsonBuffer::clone()") {
+  DynamicJsonBuffer source;
+  DynamicJsonBuffer target;
+
+  SECTION("Copies every type of value") {
+    const char* json =
+        "{\"a\":[1,-2,3.5,true,null,\"str\"],\"b\":{\"c\":{}},\"d\":[]}";
+    JsonVariant original = source.parse(json);
+    JsonVariant copy = target.clone(original);
+    REQUIRE(serialize(copy) == serialize(original));
+  }
+
+  SECTION("Copies the strings") {
+    JsonObject& original = source.createObject();
+    original["key"] = std::string("value");
+    JsonObject& copy = target.clone(original).as<JsonObject&>();
+    REQUIRE(copy["key"] == std::string("value"));
+    REQUIRE(copy.begin()->key != original.begin()->key);
+    REQUIRE(copy["key"].as<const char*>() != original["key"].as<const char*>());
+  }
+
+  SECTION("Copies scalars") {
+    REQUIRE(target.clone(42).as<int>() == 42);
+    REQUIRE(target.clone(RawJson("1e3")).as<double>() == 1e3);
+    REQUIRE_FALSE(target.clone(JsonVariant()).success());
+  }
+
+  SECTION("Allocates in depth-first order") {
+    JsonArray& original = source.parseArray("[[1,2],{\"a\":[3]},4]");
+    StaticJsonBuffer<1024> sb;
+    JsonArray& copy = sb.clone(original).as<JsonArray&>();
+    const char* first = reinterpret_cast<const char*>(&copy);
+    const char* second = reinterpret_cast<const char*>(&copy[0].as<JsonArray&>());
+    const char* third =
+        reinterpret_cast<const char*>(&copy[1].as<JsonObject&>());
+    REQUIRE(first < second);
+    REQUIRE(second < third);
+  }
+
+  SECTION("Returns undefined when the buffer is too small") {
+    JsonArray& original = source.parseArray("[1,2,3,4,5,6,7,8,9,10]");
+    StaticJsonBuffer<JSON_ARRAY_SIZE(5)> sb;
+    REQUIRE_FALSE(sb.clone(original).success());
+  }
+}
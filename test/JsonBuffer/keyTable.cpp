@@ -0,0 +1,136 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+#include <stdio.h>
+#include <string>
+
+TEST_CASE("JsonKeyTable") {
+  JsonKeyTable table;
+
+  SECTION("intern() returns the same address for the same key") {
+    const char* a = table.intern("hello");
+    const char* b = table.intern(std::string("hello").c_str());
+
+    REQUIRE(a == b);
+    REQUIRE(std::string(a) == "hello");
+    REQUIRE(table.size() == 1);
+  }
+
+  SECTION("intern() distinguishes prefixes") {
+    const char* a = table.intern("hello", 4);
+    const char* b = table.intern("hello", 5);
+
+    REQUIRE(a != b);
+    REQUIRE(std::string(a) == "hell");
+    REQUIRE(std::string(b) == "hello");
+  }
+
+  SECTION("intern() distinguishes keys with the same hash") {
+    // "enu" and "aptcaaaa" have the same FNV-1a hash
+    const char* a = table.intern("enu");
+    const char* b = table.intern("aptcaaaa");
+
+    REQUIRE(a != b);
+    REQUIRE(std::string(b) == "aptcaaaa");
+    REQUIRE(table.intern("enu") == a);
+    REQUIRE(table.size() == 2);
+  }
+
+  SECTION("Survives growing") {
+    const char* first = table.intern("k0");
+    char key[16];
+    for (int i = 0; i < 100; i++) {
+      sprintf(key, "k%d", i);
+      table.intern(key);
+    }
+
+    REQUIRE(table.size() == 100);
+    REQUIRE(table.intern("k0") == first);
+  }
+
+  SECTION("intern() returns NULL when full") {
+    JsonKeyTable small(1);
+
+    REQUIRE(small.intern("a") != NULL);
+    REQUIRE(small.intern("a") != NULL);
+    REQUIRE(small.intern("b") == NULL);
+  }
+}
+
+TEST_CASE("JsonBuffer::setKeyTable()") {
+  JsonKeyTable table;
+  DynamicJsonBuffer jb1, jb2;
+  jb1.setKeyTable(&table);
+  jb2.setKeyTable(&table);
+
+  SECTION("The documents share the keys") {
+    JsonObject& obj1 = jb1.parseObject("{\"hello\":1}");
+    JsonObject& obj2 = jb2.parseObject("{\"hello\":2}");
+
+    REQUIRE(obj1.begin()->key == obj2.begin()->key);
+    REQUIRE(obj1.begin()->key == table.intern("hello"));
+    REQUIRE(obj2["hello"] == 2);
+  }
+
+  SECTION("The keys take no room in the buffer") {
+    jb1.parseObject("{\"sensors\":1}");
+    jb2.setKeyTable(NULL);
+    jb2.parseObject("{\"sensors\":1}");
+
+    REQUIRE(jb1.size() + sizeof("sensors") == jb2.size());
+  }
+
+  SECTION("The values are not interned") {
+    JsonObject& obj = jb1.parseObject("{\"a\":\"b\"}");
+
+    REQUIRE(obj["a"] == std::string("b"));
+    REQUIRE(table.size() == 1);
+  }
+
+  SECTION("Works with in-place parsing") {
+    char json[] = "{\"hello\":\"world\"}";
+    JsonObject& obj = jb1.parseObject(json);
+
+    REQUIRE(obj.begin()->key == table.intern("hello"));
+    REQUIRE(obj["hello"] == std::string("world"));
+  }
+
+  SECTION("Handles escaped keys") {
+    JsonObject& obj = jb1.parseObject("{\"a\\tb\":1}");
+
+    REQUIRE(obj.begin()->key == table.intern("a\tb"));
+  }
+
+  SECTION("Copies long keys in the buffer") {
+    std::string key(100, 'x');
+    JsonObject& obj = jb1.parseObject("{\"" + key + "\":1}");
+
+    REQUIRE(obj[key] == 1);
+    REQUIRE(table.size() == 0);
+  }
+
+  SECTION("Copies the keys in the buffer when the table is full") {
+    JsonKeyTable small(1);
+    jb1.setKeyTable(&small);
+
+    JsonObject& obj = jb1.parseObject("{\"a\":1,\"b\":2}");
+
+    REQUIRE(obj["a"] == 1);
+    REQUIRE(obj["b"] == 2);
+    REQUIRE(small.size() == 1);
+  }
+
+  SECTION("Works with a StaticJsonBuffer") {
+    // the room for the value only
+    StaticJsonBuffer<JSON_OBJECT_SIZE(1) + 8> sb;
+    sb.setKeyTable(&table);
+
+    JsonObject& obj = sb.parseObject("{\"hello_world\":1}");
+
+    REQUIRE(obj.success());
+    REQUIRE(obj.begin()->key == table.intern("hello_world"));
+  }
+}
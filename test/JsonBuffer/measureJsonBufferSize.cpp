@@ -0,0 +1,163 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+#include "../Helpers/SpyingAllocator.hpp"
+#include <sstream>
+#include <string>
+
+using namespace ArduinoJson::Internals;
+
+namespace {
+struct RuntimeJsonBuffer : StaticJsonBufferBase {
+  RuntimeJsonBuffer(char* buffer, size_t capacity)
+      : StaticJsonBufferBase(buffer, capacity) {}
+  virtual ~RuntimeJsonBuffer() {}
+};
+
+size_t sizeAfterParse(const char* json) {
+  char memory[32768];
+  RuntimeJsonBuffer buffer(memory, sizeof(memory));
+  REQUIRE(buffer.parse(json).success());
+  return buffer.size();
+}
+
+size_t sizeAfterParseInPlace(const char* json) {
+  std::string copy(json);
+  char memory[32768];
+  RuntimeJsonBuffer buffer(memory, sizeof(memory));
+  REQUIRE(buffer.parse(&copy[0]).success());
+  return buffer.size();
+}
+
+bool parsesWithCapacity(const char* json, size_t capacity) {
+  char memory[32768];
+  RuntimeJsonBuffer buffer(memory, capacity);
+  return buffer.parse(json).success();
+}
+
+void checkExactSize(const char* json) {
+  INFO(json);
+  std::string copy(json);
+  REQUIRE(measureJsonBufferSize(json) == sizeAfterParse(json));
+  REQUIRE(measureJsonBufferSize(&copy[0]) == sizeAfterParseInPlace(json));
+  REQUIRE(measureJsonBufferSize(copy) == sizeAfterParse(json));
+}
+}  // namespace
+
+TEST_CASE("measureJsonBufferSize()") {
+  SECTION("Matches the size used by the parser") {
+    checkExactSize("[]");
+    checkExactSize("{}");
+    checkExactSize("[1,2,3]");
+    checkExactSize("[\"a\",\"bc\",\"def\",true,null,-1.5e3]");
+    checkExactSize("{\"a\":1,\"bb\":[1,{\"c\":\"d\"}],\"e\":{}}");
+    checkExactSize("{'single':'quotes', unquoted: key}");
+    checkExactSize("[\"esc\\\"aped\\n\", \"\\u0041\"]");
+    checkExactSize(" [ /* comment */ 1 , // line\n 2 ] ");
+    checkExactSize("[[[[[]]]]]");
+    checkExactSize("[,]");
+    checkExactSize("42");
+    checkExactSize("\"hello\"");
+
+    std::string big = "{";
+    for (int i = 0; i < 50; i++) {
+      if (i) big += ",";
+      big += "\"k" + std::string(1, char('A' + i % 26)) +
+             std::string(1, char('A' + i / 26)) + "\":" + "[1,{\"x\":2}]";
+    }
+    big += "}";
+    checkExactSize(big.c_str());
+  }
+
+  SECTION("Is the minimum capacity of a StaticJsonBuffer") {
+    const char* json = "{\"name\":\"value\",\"list\":[1,22,333]}";
+    size_t size = measureJsonBufferSize(json);
+    REQUIRE(parsesWithCapacity(json, size));
+    REQUIRE_FALSE(parsesWithCapacity(json, size - 1));
+  }
+
+  SECTION("Fits in the first block of a DynamicJsonBuffer") {
+    const char* json = "{\"name\":\"value\",\"list\":[1,22,333]}";
+    size_t size = measureJsonBufferSize(json);
+    DynamicJsonBuffer buffer(size);
+    REQUIRE(buffer.parseObject(json).success());
+    REQUIRE(buffer.size() == size);
+  }
+
+  SECTION("Strings take no room when parsing in place") {
+    char json[] = "[\"hello\",\"world\"]";
+    REQUIRE(measureJsonBufferSize(json) == JSON_ARRAY_SIZE(2));
+  }
+
+  SECTION("Counts the strings when the input is const") {
+    const char* json = "[\"hello\",\"world\"]";
+    REQUIRE(measureJsonBufferSize(json) >= JSON_ARRAY_SIZE(2) + 12);
+  }
+
+  SECTION("Returns 0 for invalid input") {
+    REQUIRE(measureJsonBufferSize("[1,2") == 0);
+    REQUIRE(measureJsonBufferSize("{\"a\" 1}") == 0);
+    REQUIRE(measureJsonBufferSize("[1}") == 0);
+  }
+
+  SECTION("Respects the nesting limit") {
+    REQUIRE(measureJsonBufferSize("[[]]", 1) == 0);
+    REQUIRE(measureJsonBufferSize("[[]]", 2) != 0);
+  }
+
+  SECTION("Is exact with objects sharing their keys") {
+    checkExactSize("[{\"temperature\":1},{\"temperature\":2}]");
+  }
+
+  SECTION("Doesn't modify a writable input") {
+    char json[] = "[\"hello\",\"wor\\u006cd\"]";
+    measureJsonBufferSize(json);
+    REQUIRE(std::string(json) == "[\"hello\",\"wor\\u006cd\"]");
+  }
+
+  SECTION("Is exact with duplicate keys") {
+    checkExactSize("{\"a\":1,\"a\":2}");
+  }
+
+  SECTION("Is exact with the keys of the previous objects") {
+    checkExactSize("[{\"a\":1,\"b\":2},{\"a\":3,\"c\":4,\"d\":5},{}]");
+    checkExactSize("[{\"a\":1,\"b\":2,\"a\":3},{\"a\":4,\"b\":5}]");
+    checkExactSize("[{\"a\":{\"x\":[1]}},{\"a\":2},3,{\"a\":4}]");
+    checkExactSize("[{'a':1, b : 2},{\"\\u0061\":3,\"b\":4}]");
+
+    std::string longKey(100, 'k');
+    std::string json = "[{\"" + longKey + "\":1},{\"" + longKey + "\":2}]";
+    checkExactSize(json.c_str());
+  }
+
+  SECTION("Is exact with a big array of records") {
+    std::ostringstream json;
+    json << '[';
+    for (int i = 0; i < 50; i++)
+      json << (i ? "," : "") << "{\"id\":" << i << ",\"name\":\"item" << i
+           << "\",\"tags\":[\"x\",\"y\"],\"id\":" << -i << '}';
+    json << ']';
+    checkExactSize(json.str().c_str());
+  }
+
+  SECTION("Doesn't allocate") {
+    const char* json = "{\"name\":\"value\",\"list\":[1,22,333]}";
+    allocatorLog().clear();
+    size_t size = measureJsonBufferSize(json);
+    REQUIRE(allocatorLog().str() == "");
+
+    // so the parser needs a single block of that size
+    {
+      DynamicJsonBufferBase<SpyingAllocator> buffer(size);
+      REQUIRE(buffer.parse(json).success());
+      REQUIRE(buffer.size() == size);
+    }
+    std::ostringstream expected;
+    expected << "A" << size << "F";
+    REQUIRE(allocatorLog().str() == expected.str());
+  }
+}
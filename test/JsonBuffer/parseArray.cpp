@@ -4,6 +4,8 @@
 
 #include <ArduinoJson.h>
 #include <catch.hpp>
+#include <sstream>
+#include <string>
 
 TEST_CASE("JsonBuffer::parseArray()") {
   DynamicJsonBuffer jb;
@@ -180,6 +182,85 @@ TEST_CASE("JsonBuffer::parseArray()") {
     REQUIRE(arr[0] == "1\"2\\3/4\b5\f6\n7\r8\t9");
   }
 
+  SECTION("LongStringsWithEscapedChars") {
+    const char* json =
+        "[\"the quick brown fox\\njumps over\\t\\\"the lazy dog\\\"\","
+        "'it\\'s a \"test\" of single quotes',\"\"]";
+    const char* expected0 = "the quick brown fox\njumps over\t\"the lazy dog\"";
+    const char* expected1 = "it's a \"test\" of single quotes";
+
+    SECTION("const char*") {
+      JsonArray& arr = jb.parseArray(json);
+      REQUIRE(arr[0] == expected0);
+      REQUIRE(arr[1] == expected1);
+      REQUIRE(arr[2] == "");
+    }
+
+    SECTION("char*") {
+      std::string copy(json);
+      JsonArray& arr = jb.parseArray(&copy[0]);
+      REQUIRE(arr[0] == expected0);
+      REQUIRE(arr[1] == expected1);
+      REQUIRE(arr[2] == "");
+    }
+
+    SECTION("std::string") {
+      JsonArray& arr = jb.parseArray(std::string(json));
+      REQUIRE(arr[0] == expected0);
+      REQUIRE(arr[1] == expected1);
+      REQUIRE(arr[2] == "");
+    }
+
+    SECTION("std::istream") {
+      std::istringstream stream(json);
+      JsonArray& arr = jb.parseArray(stream);
+      REQUIRE(arr[0] == expected0);
+      REQUIRE(arr[1] == expected1);
+      REQUIRE(arr[2] == "");
+    }
+  }
+
+  SECTION("LongRunsOfSpaces") {
+    std::string indent(40, ' ');
+    std::string json = "[\n" + indent + "1,\n" + indent + "\t\"two\" \r\n" +
+                       indent + "/* comment */" + indent + "]" + indent;
+
+    SECTION("const char*") {
+      JsonArray& arr = jb.parseArray(json.c_str());
+      REQUIRE(2 == arr.size());
+      REQUIRE(1 == arr[0]);
+      REQUIRE(arr[1] == "two");
+    }
+
+    SECTION("std::istream") {
+      std::istringstream stream(json);
+      JsonArray& arr = jb.parseArray(stream);
+      REQUIRE(2 == arr.size());
+      REQUIRE(1 == arr[0]);
+      REQUIRE(arr[1] == "two");
+    }
+  }
+
+  SECTION("LongUnquotedValues") {
+    std::string value(40, 'x');
+    std::string json = "[" + value + "," + value + "1 ]";
+
+    SECTION("const char*") {
+      JsonArray& arr = jb.parseArray(json.c_str());
+      REQUIRE(2 == arr.size());
+      REQUIRE(arr[0] == value);
+      REQUIRE(arr[1] == value + "1");
+    }
+
+    SECTION("std::istream") {
+      std::istringstream stream(json);
+      JsonArray& arr = jb.parseArray(stream);
+      REQUIRE(2 == arr.size());
+      REQUIRE(arr[0] == value);
+      REQUIRE(arr[1] == value + "1");
+    }
+  }
+
   SECTION("StringWithUnterminatedEscapeSequence") {
     JsonArray& arr = jb.parseArray("\"\\\0\"", 4);
     REQUIRE_FALSE(arr.success());
@@ -315,4 +396,29 @@ TEST_CASE("JsonBuffer::parseArray()") {
         jb.parseArray("[[[[[[[[[[[[[[[[[[[\"Not too deep\"]]]]]]]]]]]]]]]]]]]");
     REQUIRE(arr.success());
   }
+
+  SECTION("Objects with the same keys") {
+    JsonArray& arr = jb.parseArray(
+        "[{\"a\":1,\"b\":2},{\"a\":3,\"b\":4},{\"b\":5,\"c\":6}]");
+    REQUIRE(arr.success());
+
+    JsonObject::const_iterator first = arr[0].as<const JsonObject&>().begin();
+    JsonObject::const_iterator second = arr[1].as<const JsonObject&>().begin();
+    JsonObject::const_iterator third = arr[2].as<const JsonObject&>().begin();
+
+    SECTION("share the keys with the previous object") {
+      REQUIRE(first->key == second->key);
+      REQUIRE((++first)->key == (++second)->key);
+    }
+
+    SECTION("only at the same position") {
+      REQUIRE(std::string(third->key) == "b");
+      REQUIRE(third->key != second->key);
+    }
+
+    SECTION("keep their own values") {
+      REQUIRE(arr[1]["a"] == 3);
+      REQUIRE(arr[2]["c"] == 6);
+    }
+  }
 }
@@ -4,6 +4,7 @@
 
 #include <ArduinoJson.h>
 #include <catch.hpp>
+#include <string>
 
 TEST_CASE("JsonBuffer::parseObject()") {
   DynamicJsonBuffer jb;
@@ -167,4 +168,27 @@ TEST_CASE("JsonBuffer::parseObject()") {
       REQUIRE_FALSE(obj.success());
     }
   }
+
+  SECTION("Duplicate keys") {
+    SECTION("The last value wins") {
+      JsonObject& obj = jb.parseObject("{\"a\":1,\"b\":2,\"a\":3}");
+      REQUIRE(obj.success());
+      REQUIRE(obj.size() == 2);
+      REQUIRE(obj["a"] == 3);
+      REQUIRE(obj["b"] == 2);
+    }
+
+    SECTION("The first position is kept") {
+      std::string json;
+      jb.parseObject("{\"a\":1,\"b\":2,\"a\":3}").printTo(json);
+      REQUIRE(json == "{\"a\":3,\"b\":2}");
+    }
+
+    SECTION("In a nested object") {
+      JsonObject& obj = jb.parseObject("{\"a\":{\"b\":1,\"b\":2}}");
+      REQUIRE(obj.success());
+      REQUIRE(obj["a"].as<JsonObject>().size() == 1);
+      REQUIRE(obj["a"]["b"] == 2);
+    }
+  }
 }
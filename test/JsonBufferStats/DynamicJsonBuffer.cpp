@@ -0,0 +1,102 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#define ARDUINOJSON_ENABLE_STATS 1
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+static void checkTotal(const DynamicJsonBuffer& buffer) {
+  JsonBufferStats stats = buffer.stats();
+  REQUIRE(buffer.size() == stats.requested + stats.padding);
+}
+
+TEST_CASE("DynamicJsonBuffer::stats()") {
+  const size_t word = sizeof(void*);
+
+  SECTION("Initial values") {
+    DynamicJsonBuffer buffer;
+    JsonBufferStats stats = buffer.stats();
+    REQUIRE(0 == stats.requested);
+    REQUIRE(0 == stats.padding);
+    REQUIRE(0 == stats.abandoned);
+    REQUIRE(0 == stats.blocks);
+    REQUIRE(0 == stats.largestBlock);
+    REQUIRE(0 == stats.highWaterMark);
+  }
+
+  SECTION("Counts requested bytes and padding") {
+    DynamicJsonBuffer buffer;
+    buffer.alloc(1);
+    buffer.alloc(1);
+    JsonBufferStats stats = buffer.stats();
+    REQUIRE(2 == stats.requested);
+    REQUIRE(word - 1 == stats.padding);
+    checkTotal(buffer);
+  }
+
+  SECTION("Counts blocks") {
+    DynamicJsonBuffer buffer(word);
+    buffer.alloc(word);
+    buffer.alloc(word);
+    buffer.alloc(10 * word);
+    JsonBufferStats stats = buffer.stats();
+    REQUIRE(3 == stats.blocks);
+    REQUIRE(10 * word == stats.largestBlock);
+  }
+
+  SECTION("Counts abandoned bytes") {
+    DynamicJsonBuffer buffer(2 * word);
+    buffer.alloc(1);
+    buffer.alloc(2 * word);
+    JsonBufferStats stats = buffer.stats();
+    REQUIRE(word == stats.abandoned);  // after padding
+    checkTotal(buffer);
+  }
+
+  SECTION("Doesn't abandon strings that move to a new block") {
+    DynamicJsonBuffer buffer(4);
+    DynamicJsonBuffer::String str = buffer.startString();
+    str.append('h');
+    str.append('e');
+    str.append('l');
+    str.append('l');
+    str.append('o');
+    str.c_str();
+    JsonBufferStats stats = buffer.stats();
+    REQUIRE(6 == stats.requested);
+    REQUIRE(0 == stats.abandoned);
+    REQUIRE(1 == stats.blocks);
+    checkTotal(buffer);
+  }
+
+  SECTION("Keeps the high water mark after clear()") {
+    DynamicJsonBuffer buffer;
+    buffer.alloc(42);
+    buffer.clear();
+    buffer.alloc(1);
+    JsonBufferStats stats = buffer.stats();
+    REQUIRE(1 == stats.requested);
+    REQUIRE(0 == stats.padding);
+    REQUIRE(1 == stats.blocks);
+    REQUIRE(42 == stats.highWaterMark);
+  }
+
+  SECTION("Keeps the high water mark after recycle()") {
+    DynamicJsonBuffer buffer(word);
+    buffer.alloc(word);
+    buffer.alloc(word);
+    buffer.recycle();
+    JsonBufferStats stats = buffer.stats();
+    REQUIRE(0 == stats.requested);
+    REQUIRE(1 == stats.blocks);
+    REQUIRE(2 * word == stats.largestBlock);
+    REQUIRE(2 * word == stats.highWaterMark);
+  }
+
+  SECTION("Adds up after parsing") {
+    DynamicJsonBuffer buffer(16);
+    buffer.parseObject("{\"hello\":\"world\",\"values\":[1,2,3]}");
+    checkTotal(buffer);
+  }
+}
@@ -0,0 +1,71 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#define ARDUINOJSON_ENABLE_STATS 1
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+using namespace ArduinoJson::Internals;
+
+TEST_CASE("StaticJsonBuffer::stats()") {
+  const size_t word = sizeof(void*);
+  StaticJsonBuffer<256> buffer;
+
+  SECTION("Initial values") {
+    JsonBufferStats stats = buffer.stats();
+    REQUIRE(0 == stats.requested);
+    REQUIRE(0 == stats.padding);
+    REQUIRE(0 == stats.abandoned);
+    REQUIRE(1 == stats.blocks);
+    REQUIRE(256 == stats.largestBlock);
+    REQUIRE(0 == stats.highWaterMark);
+  }
+
+  SECTION("Counts requested bytes and padding") {
+    buffer.alloc(1);
+    buffer.alloc(1);
+    JsonBufferStats stats = buffer.stats();
+    REQUIRE(2 == stats.requested);
+    REQUIRE(word - 1 == stats.padding);
+  }
+
+  SECTION("Counts strings") {
+    StaticJsonBufferBase::String str = buffer.startString();
+    str.append('h');
+    str.append('i');
+    str.c_str();
+    REQUIRE(3 == buffer.stats().requested);
+  }
+
+  SECTION("Doesn't count failed allocations") {
+    buffer.alloc(300);
+    REQUIRE(0 == buffer.stats().requested);
+  }
+
+  SECTION("Keeps the high water mark after clear()") {
+    buffer.alloc(42);
+    buffer.clear();
+    buffer.alloc(1);
+    JsonBufferStats stats = buffer.stats();
+    REQUIRE(1 == stats.requested);
+    REQUIRE(42 == stats.highWaterMark);
+  }
+
+  SECTION("Adds up after parsing") {
+    buffer.parseObject("{\"hello\":\"world\",\"values\":[1,2,3]}");
+    JsonBufferStats stats = buffer.stats();
+    REQUIRE(buffer.size() == stats.requested + stats.padding);
+  }
+
+  SECTION("Restores the counters after release()") {
+    buffer.alloc(1);
+    StaticJsonBufferBase::Mark mark = buffer.mark();
+    buffer.alloc(42);
+    buffer.release(mark);
+    JsonBufferStats stats = buffer.stats();
+    REQUIRE(1 == stats.requested);
+    REQUIRE(0 == stats.padding);
+    REQUIRE(sizeof(void*) + 42 == stats.highWaterMark);
+  }
+}
@@ -0,0 +1,117 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+#include <sstream>
+#include <string>
+
+static std::string keyOf(int i) {
+  std::ostringstream s;
+  s << "key" << i;
+  return s.str();
+}
+
+TEST_CASE("JsonObject index") {
+  DynamicJsonBuffer jb;
+  JsonObject& obj = jb.createObject();
+  for (int i = 0; i < 100; i++) obj[keyOf(i)] = i;
+
+  SECTION("Finds every key") {
+    REQUIRE(obj.size() == 100);
+    for (int i = 0; i < 100; i++) REQUIRE(obj[keyOf(i)] == i);
+    REQUIRE(obj.get<int>("key42") == 42);
+    REQUIRE_FALSE(obj.containsKey("key100"));
+  }
+
+  SECTION("set() replaces the existing value") {
+    obj["key7"] = 700;
+    REQUIRE(obj.size() == 100);
+    REQUIRE(obj["key7"] == 700);
+  }
+
+  SECTION("remove()") {
+    obj.remove("key0");
+    obj.remove("key50");
+    obj.remove("key99");
+    REQUIRE(obj.size() == 97);
+    REQUIRE_FALSE(obj.containsKey("key0"));
+    REQUIRE_FALSE(obj.containsKey("key50"));
+    REQUIRE_FALSE(obj.containsKey("key99"));
+    for (int i = 1; i < 99; i++)
+      if (i != 50) REQUIRE(obj[keyOf(i)] == i);
+  }
+
+  SECTION("Keys added after a removal") {
+    obj.remove("key99");
+    obj["key99"] = 990;
+    obj["key100"] = 1000;
+    REQUIRE(obj["key99"] == 990);
+    REQUIRE(obj["key100"] == 1000);
+    REQUIRE(obj.size() == 101);
+  }
+
+  SECTION("Remove everything") {
+    for (int i = 0; i < 100; i++) obj.remove(keyOf(i));
+    REQUIRE(obj.size() == 0);
+    obj["again"] = 1;
+    REQUIRE(obj["again"] == 1);
+  }
+
+  SECTION("Finds the first of duplicate keys") {
+    DynamicJsonBuffer jb2;
+    JsonObject& parsed =
+        jb2.parseObject("{\"a\":1,\"b\":2,\"c\":3,\"d\":4,\"e\":5,\"f\":6,"
+                        "\"g\":7,\"h\":8,\"i\":9,\"j\":10,\"k\":11,\"l\":12,"
+                        "\"m\":13,\"n\":14,\"o\":15,\"p\":16,\"q\":17}");
+    REQUIRE(parsed.size() == 17);
+    JsonObject::iterator it = parsed.begin();
+    it->key = "q";
+    REQUIRE(parsed["q"] == 1);
+  }
+
+#if ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+  SECTION("Const searches don't allocate") {
+    StaticJsonBuffer<JSON_OBJECT_SIZE(21) + 128 * sizeof(void*)> sb;
+    JsonObject& small = sb.createObject();
+    const char* keys[] = {"a", "b", "c", "d", "e", "f", "g", "h", "i", "j",
+                          "k", "l", "m", "n", "o", "p", "q", "r", "s", "t"};
+    for (int i = 0; i < 20; i++) REQUIRE(small.set(keys[i], i));
+    small.begin()->key = "z";
+    size_t size = sb.size();
+
+    const JsonObject& csmall = small;
+    REQUIRE(csmall.get<int>("z") == 0);
+    REQUIRE(csmall["t"] == 19);
+    REQUIRE_FALSE(csmall.containsKey("a"));
+    REQUIRE(sb.size() == size);
+
+    // the hash table is rebuilt in the same segments
+    REQUIRE(small.set("u", 20));
+    REQUIRE(sb.size() == size + sizeof(JsonObject::node_type));
+    REQUIRE(csmall["z"] == 0);
+    REQUIRE(csmall["u"] == 20);
+  }
+
+  SECTION("The hash table takes about two pointers per key") {
+    std::string keys[100];
+    for (int i = 0; i < 100; i++) keys[i] = keyOf(i);
+    StaticJsonBuffer<JSON_OBJECT_SIZE(100) + 400 * sizeof(void*)> sb;
+    JsonObject& big = sb.createObject();
+    for (int i = 0; i < 100; i++) REQUIRE(big.set(keys[i].c_str(), i));
+    REQUIRE(sb.size() - JSON_OBJECT_SIZE(100) < 100 * 3 * sizeof(void*));
+    for (int i = 0; i < 100; i++) REQUIRE(big[keys[i].c_str()] == i);
+  }
+
+  SECTION("Falls back to a linear search when the buffer is full") {
+    StaticJsonBuffer<JSON_OBJECT_SIZE(20)> sb;
+    JsonObject& small = sb.createObject();
+    const char* keys[] = {"a", "b", "c", "d", "e", "f", "g", "h", "i", "j",
+                          "k", "l", "m", "n", "o", "p", "q", "r", "s", "t"};
+    for (int i = 0; i < 20; i++) REQUIRE(small.set(keys[i], i));
+    REQUIRE(small["t"] == 19);
+    REQUIRE(small["a"] == 0);
+  }
+#endif
+}
@@ -0,0 +1,54 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+#include <string>
+
+TEST_CASE("JsonObject key hashes") {
+  DynamicJsonBuffer jb;
+  JsonObject& obj = jb.createObject();
+
+  SECTION("Distinguishes keys with a common prefix") {
+    obj["sensor_temperature_1"] = 1;
+    obj["sensor_temperature_2"] = 2;
+
+    REQUIRE(obj["sensor_temperature_1"] == 1);
+    REQUIRE(obj["sensor_temperature_2"] == 2);
+    REQUIRE_FALSE(obj.containsKey("sensor_temperature_3"));
+  }
+
+  SECTION("Matches all the string types") {
+    obj[std::string("hello")] = 1;
+
+    REQUIRE(obj["hello"] == 1);
+    REQUIRE(obj[const_cast<char*>("hello")] == 1);
+    REQUIRE(obj[std::string("hello")] == 1);
+  }
+
+  SECTION("Finds the keys of a parsed object") {
+    JsonObject& parsed = jb.parseObject("{\"a\":1,\"b\":2}");
+
+    REQUIRE(parsed["b"] == 2);
+  }
+
+  SECTION("Finds a key changed through an iterator") {
+    obj["a"] = 1;
+    obj["b"] = 2;
+
+    obj.begin()->key = "c";
+
+    REQUIRE(obj["c"] == 1);
+    REQUIRE_FALSE(obj.containsKey("a"));
+  }
+
+  SECTION("Finds the keys of a clone") {
+    obj["a"] = 1;
+    obj["b"] = 2;
+
+    JsonObject& clone = jb.clone(obj);
+
+    REQUIRE(clone["b"] == 2);
+  }
+}
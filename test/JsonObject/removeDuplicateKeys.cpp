@@ -0,0 +1,103 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+#include <time.h>
+#include <sstream>
+#include <string>
+
+TEST_CASE("JsonObject::removeDuplicateKeys()") {
+  DynamicJsonBuffer jb;
+  JsonObject& obj = jb.createObject();
+
+  SECTION("Does nothing without duplicates") {
+    obj["a"] = 1;
+    obj["b"] = 2;
+
+    obj.removeDuplicateKeys();
+
+    REQUIRE(obj.size() == 2);
+  }
+
+  SECTION("Does nothing on an empty object") {
+    obj.removeDuplicateKeys();
+
+    REQUIRE(obj.size() == 0);
+  }
+
+  SECTION("Keeps the first position and the last value") {
+    JsonObject& parsed = jb.parseObject("{\"a\":1,\"b\":2,\"a\":3,\"a\":4}");
+
+    parsed.removeDuplicateKeys();
+
+    std::string json;
+    parsed.printTo(json);
+    REQUIRE(json == "{\"a\":4,\"b\":2}");
+  }
+
+  SECTION("Removes the last pair") {
+    JsonObject& parsed = jb.parseObject("{\"a\":1,\"b\":2,\"b\":3}");
+
+    parsed.removeDuplicateKeys();
+    parsed["c"] = 4;
+
+    std::string json;
+    parsed.printTo(json);
+    REQUIRE(json == "{\"a\":1,\"b\":3,\"c\":4}");
+  }
+
+  SECTION("Works on big objects") {
+    std::ostringstream json;
+    json << '{';
+    for (int i = 0; i < 100; i++) json << "\"k" << i % 50 << "\":" << i << ',';
+    json << "\"k0\":-1}";
+
+    JsonObject& parsed = jb.parseObject(json.str());
+    parsed.removeDuplicateKeys();
+
+    REQUIRE(parsed.size() == 50);
+    REQUIRE(parsed["k0"] == -1);
+    REQUIRE(parsed["k49"] == 99);
+    REQUIRE(parsed.begin()->key == std::string("k0"));
+  }
+
+#if ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+  SECTION("Merges the big objects in one pass") {
+    // the quadratic version took about 4 seconds
+    std::ostringstream json;
+    json << '{';
+    for (int i = 0; i < 40000; i++)
+      json << "\"k" << i % 20000 << "\":" << i << ',';
+    json << "\"k0\":-1}";
+    std::string input = json.str();
+
+    clock_t start = clock();
+    JsonObject& parsed = jb.parseObject(&input[0]);
+    parsed.removeDuplicateKeys();
+    clock_t elapsed = clock() - start;
+
+    REQUIRE(parsed.size() == 20000);
+    REQUIRE(parsed["k0"] == -1);
+    REQUIRE(parsed["k19999"] == 39999);
+    REQUIRE(elapsed < CLOCKS_PER_SEC / 2);
+  }
+
+  SECTION("The hash table is kept for the searches") {
+    std::ostringstream json;
+    json << '{';
+    for (int i = 0; i < 100; i++) json << "\"k" << i % 50 << "\":" << i << ',';
+    json << "\"k0\":-1}";
+
+    JsonObject& parsed = jb.parseObject(json.str());
+    size_t size = jb.size();
+    for (int i = 1; i < 50; i++) {
+      std::ostringstream key;
+      key << 'k' << i;
+      REQUIRE(parsed[key.str()] == i + 50);
+    }
+    REQUIRE(jb.size() == size);
+  }
+#endif
+}
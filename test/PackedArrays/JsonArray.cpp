@@ -0,0 +1,118 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#define ARDUINOJSON_ENABLE_PACKED_ARRAYS 1
+#include <ArduinoJson.h>
+#include <catch.hpp>
+#include <string>
+
+using namespace ArduinoJson::Internals;
+
+static std::string toJson(const JsonArray& arr) {
+  std::string json;
+  arr.printTo(json);
+  return json;
+}
+
+TEST_CASE("JsonArray with packed values") {
+  DynamicJsonBuffer jb;
+  JsonArray& arr = jb.parseArray("[10,20,30]");
+  REQUIRE(arr.isPacked());
+
+  SECTION("packedData()") {
+    const JsonInteger* integers = NULL;
+    REQUIRE(3 == arr.packedData(0, integers));
+    REQUIRE(10 == integers[0]);
+    REQUIRE(30 == integers[2]);
+    REQUIRE(1 == arr.packedData(2, integers));
+    REQUIRE(0 == arr.packedData(3, integers));
+
+    const JsonFloat* floats = NULL;
+    REQUIRE(0 == arr.packedData(0, floats));
+  }
+
+  SECTION("packedData() with floats") {
+    JsonArray& floatArr = jb.parseArray("[1,0.5]");
+    const JsonFloat* floats = NULL;
+    REQUIRE(2 == floatArr.packedData(0, floats));
+    REQUIRE(1.0 == floats[0]);
+    REQUIRE(0.5 == floats[1]);
+  }
+
+  SECTION("copyTo()") {
+    int values[4] = {0};
+    REQUIRE(3 == arr.copyTo(values));
+    REQUIRE(10 == values[0]);
+    REQUIRE(30 == values[2]);
+    REQUIRE(arr.isPacked());
+  }
+
+  SECTION("Out of range") {
+    REQUIRE(0 == arr[3].as<int>());
+    REQUIRE_FALSE(arr[3].is<int>());
+  }
+
+  SECTION("add() unpacks") {
+    arr.add("forty");
+    REQUIRE_FALSE(arr.isPacked());
+    REQUIRE(std::string("[10,20,30,\"forty\"]") == toJson(arr));
+  }
+
+  SECTION("set() unpacks") {
+    arr[1] = 21;
+    REQUIRE_FALSE(arr.isPacked());
+    REQUIRE(std::string("[10,21,30]") == toJson(arr));
+  }
+
+  SECTION("Iteration unpacks") {
+    int sum = 0;
+    for (JsonArray::iterator it = arr.begin(); it != arr.end(); ++it)
+      sum += it->as<int>();
+    REQUIRE(60 == sum);
+    REQUIRE_FALSE(arr.isPacked());
+    REQUIRE(3 == arr.size());
+  }
+
+  SECTION("Const iteration doesn't unpack") {
+    const JsonArray& constArr = arr;
+    int sum = 0;
+    for (JsonArray::const_iterator it = constArr.begin(); it != constArr.end();
+         ++it)
+      sum += it->as<int>();
+    REQUIRE(60 == sum);
+    REQUIRE(arr.isPacked());
+  }
+
+  SECTION("clone()") {
+    DynamicJsonBuffer other;
+    JsonArray& copy = other.clone(arr).as<JsonArray&>();
+    REQUIRE(copy.isPacked());
+    REQUIRE(std::string("[10,20,30]") == toJson(copy));
+  }
+}
+
+TEST_CASE("JsonArray with packed values in a small buffer") {
+  StaticJsonBuffer<JSON_ARRAY_SIZE(8)> jb;
+  JsonArray& arr = jb.parseArray("[1,2,3,4,5,6,7,8]");
+  REQUIRE(arr.isPacked());
+
+  SECTION("Const iteration reads all the values") {
+    const JsonArray& constArr = arr;
+    int count = 0;
+    for (JsonArray::const_iterator it = constArr.begin(); it != constArr.end();
+         ++it)
+      REQUIRE(++count == it->as<int>());
+    REQUIRE(8 == count);
+    REQUIRE(std::string("[1,2,3,4,5,6,7,8]") == toJson(arr));
+  }
+
+  SECTION("A failed conversion keeps the values") {
+    REQUIRE_FALSE(arr.add(9));
+    REQUIRE(arr.begin() == arr.end());
+    REQUIRE(arr.isPacked());
+    REQUIRE(8 == arr.size());
+    REQUIRE(8 == arr[7].as<int>());
+    REQUIRE(std::string("[1,2,3,4,5,6,7,8]") == toJson(arr));
+  }
+}
@@ -0,0 +1,145 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#define ARDUINOJSON_ENABLE_PACKED_ARRAYS 1
+#include <ArduinoJson.h>
+#include <catch.hpp>
+#include <stdio.h>
+#include <string>
+
+static std::string toJson(const JsonArray& arr) {
+  std::string json;
+  arr.printTo(json);
+  return json;
+}
+
+// "0,1,2,...,n-1"
+static std::string numbers(int n) {
+  std::string result;
+  for (int i = 0; i < n; i++) {
+    char tmp[16];
+    sprintf(tmp, i ? ",%d" : "%d", i);
+    result += tmp;
+  }
+  return result;
+}
+
+static size_t sizeAfterParse(const char* json) {
+  DynamicJsonBuffer jb(32768);
+  REQUIRE(jb.parseArray(json).success());
+  return jb.size();
+}
+
+TEST_CASE("Parse packed arrays") {
+  DynamicJsonBuffer jb;
+
+  SECTION("Integers") {
+    JsonArray& arr = jb.parseArray("[1, -2, +3, 42]");
+    REQUIRE(arr.success());
+    REQUIRE(arr.isPacked());
+    REQUIRE(4 == arr.size());
+    REQUIRE(-2 == arr[1].as<int>());
+    REQUIRE(3 == arr[2].as<int>());
+    REQUIRE(arr[3].is<int>());
+  }
+
+  SECTION("Floats") {
+    JsonArray& arr = jb.parseArray("[1,2.5,-1e3]");
+    REQUIRE(arr.isPacked());
+    REQUIRE(arr[0].is<float>());
+    REQUIRE(1.0 == arr[0].as<double>());
+    REQUIRE(2.5 == arr[1].as<double>());
+    REQUIRE(-1000.0 == arr[2].as<double>());
+  }
+
+  SECTION("More values than a chunk") {
+    std::string json = "[" + numbers(100) + "]";
+    JsonArray& arr = jb.parseArray(json);
+    REQUIRE(arr.isPacked());
+    REQUIRE(100 == arr.size());
+    REQUIRE(99 == arr[99].as<int>());
+    REQUIRE(json == toJson(arr));
+  }
+
+  SECTION("Not a number") {
+    JsonArray& arr = jb.parseArray("[1,2,\"three\"]");
+    REQUIRE(arr.success());
+    REQUIRE_FALSE(arr.isPacked());
+    REQUIRE(3 == arr.size());
+    REQUIRE(2 == arr[1].as<int>());
+    REQUIRE(std::string("three") == arr[2].as<char*>());
+  }
+
+  SECTION("Starts like a number") {
+    JsonArray& arr = jb.parseArray("[1,2e,3]");
+    REQUIRE_FALSE(arr.isPacked());
+    REQUIRE(std::string("[1,2e,3]") == toJson(arr));
+  }
+
+  SECTION("Largest integers") {
+    JsonArray& arr =
+        jb.parseArray("[9223372036854775807,-9223372036854775808]");
+    REQUIRE(arr.isPacked());
+    REQUIRE(std::string("[9223372036854775807,-9223372036854775808]") ==
+            toJson(arr));
+  }
+
+  SECTION("Integers that don't fit") {
+    JsonArray& arr = jb.parseArray("[128,300,-129]");
+    REQUIRE(arr.isPacked());
+    REQUIRE(127 == arr[0].as<signed char>());
+    REQUIRE(255 == arr[1].as<unsigned char>());
+    REQUIRE(-128 == arr[2].as<signed char>());
+    REQUIRE(0 == arr[2].as<unsigned char>());
+  }
+
+  SECTION("Integer that overflows") {
+    JsonArray& arr = jb.parseArray("[1,12345678901234567890]");
+    REQUIRE_FALSE(arr.isPacked());
+    REQUIRE(std::string("12345678901234567890") == arr[1].as<char*>());
+  }
+
+  SECTION("Very long token") {
+    std::string digits(100, '1');
+    JsonArray& arr = jb.parseArray("[0," + digits + "x]");
+    REQUIRE_FALSE(arr.isPacked());
+    REQUIRE(digits + "x" == arr[1].as<char*>());
+  }
+
+  SECTION("Array of arrays") {
+    JsonArray& arr = jb.parseArray("[[1,2],[3.5]]");
+    REQUIRE_FALSE(arr.isPacked());
+    REQUIRE(arr[0].as<JsonArray>().isPacked());
+    REQUIRE(3.5 == arr[1][0].as<double>());
+  }
+
+  SECTION("Invalid input") {
+    REQUIRE_FALSE(jb.parseArray("[1 2]").success());
+    REQUIRE_FALSE(jb.parseArray("[1,2").success());
+    REQUIRE_FALSE(jb.parseArray("[1a b]").success());
+  }
+
+  SECTION("In place") {
+    char json[] = "[1,2,x]";
+    JsonArray& arr = jb.parseArray(json);
+    REQUIRE(std::string("x") == arr[2].as<char*>());
+  }
+
+  SECTION("Buffer too small") {
+    StaticJsonBuffer<JSON_ARRAY_SIZE(0) + 8> sb;
+    REQUIRE_FALSE(sb.parseArray("[1,2]").success());
+  }
+
+  SECTION("measureJsonBufferSize() is exact") {
+    const char* inputs[] = {"[1,2,3]", "[1,2.5,\"a\",4]", "[1,2e,3]",
+                            "[[1],{\"a\":[2,3]},4]", "[x,1,2]"};
+    for (size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); i++) {
+      INFO(inputs[i]);
+      REQUIRE(measureJsonBufferSize(inputs[i]) == sizeAfterParse(inputs[i]));
+    }
+
+    std::string big = "[" + numbers(2000) + ",x]";
+    REQUIRE(measureJsonBufferSize(big) == sizeAfterParse(big.c_str()));
+  }
+}
@@ -4,6 +4,8 @@
 
 #include <ArduinoJson/Polyfills/parseFloat.hpp>
 #include <catch.hpp>
+#include <clocale>
+#include <string>
 
 using namespace ArduinoJson::Internals;
 
@@ -175,3 +177,61 @@ TEST_CASE("parseFloat<double>()") {
     check<double>("true", 1.0);
   }
 }
+
+#if ARDUINOJSON_ENABLE_EXACT_FLOAT_PARSING
+void checkExact(const char* input, double expected) {
+  CAPTURE(input);
+  REQUIRE(parseFloat<double>(input) == expected);
+}
+
+TEST_CASE("parseFloat<double>() rounds correctly") {
+  SECTION("Short") {
+    checkExact("0.1", 0.1);
+    checkExact("0.3", 0.3);
+    checkExact("-65.613616999999977", -65.613616999999977);
+    checkExact("1e23", 1e23);
+  }
+
+  SECTION("Halfway") {
+    checkExact("9007199254740993", 9007199254740992.0);
+    checkExact("9007199254740995", 9007199254740996.0);
+    checkExact("9007199254740993.0000000000001", 9007199254740994.0);
+  }
+
+  SECTION("Largest") {
+    checkExact("1.7976931348623157e308", 1.7976931348623157e308);
+    checkInf<double>("1.7976931348623159e308", false);
+  }
+
+  SECTION("Subnormal") {
+    checkExact("2.2250738585072011e-308", 2.2250738585072011e-308);
+    checkExact("4.9406564584124654e-324", 4.9406564584124654e-324);
+    checkExact("2.4703282292062328e-324", 4.9406564584124654e-324);
+    checkExact("2.4703282292062327e-324", 0.0);
+  }
+
+  SECTION("MoreThan19Digits") {
+    checkExact("123456789012345678901234567890", 1.2345678901234568e29);
+    checkExact("0.1000000000000000055511151231257827",
+               0.1000000000000000055511151231257827);
+  }
+
+  SECTION("MoreThan800Digits") {
+    std::string halfway = "9007199254740993." + std::string(800, '0');
+    checkExact(halfway.c_str(), 9007199254740992.0);
+    checkExact((halfway + "1").c_str(), 9007199254740994.0);
+    checkExact(("0." + std::string(800, '0') + "1e800").c_str(), 0.1);
+  }
+
+  SECTION("Ignores the locale") {
+    const char* locales[] = {"de_DE.UTF-8", "fr_FR.UTF-8", "de_DE", "fr_FR"};
+    for (size_t i = 0; i < sizeof(locales) / sizeof(locales[0]); i++) {
+      if (!setlocale(LC_NUMERIC, locales[i])) continue;
+      checkExact("0.1000000000000000055511151231257827",
+                 0.1000000000000000055511151231257827);
+      checkExact("123456789012345678901234567890", 1.2345678901234568e29);
+    }
+    setlocale(LC_NUMERIC, "C");
+  }
+}
+#endif
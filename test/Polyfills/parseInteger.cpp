@@ -21,8 +21,8 @@ TEST_CASE("parseInteger<int8_t>()") {
   check<int8_t>("+127", 127);
   check<int8_t>("3.14", 3);
   check<int8_t>("x42", 0);
-  check<int8_t>("128", -128);
-  check<int8_t>("-129", 127);
+  check<int8_t>("128", 127);
+  check<int8_t>("-129", -128);
   check<int8_t>(NULL, 0);
   check<int8_t>("true", 1);
   check<int8_t>("false", 0);
@@ -34,8 +34,8 @@ TEST_CASE("parseInteger<int16_t>()") {
   check<int16_t>("+32767", 32767);
   check<int16_t>("3.14", 3);
   check<int16_t>("x42", 0);
-  check<int16_t>("-32769", 32767);
-  check<int16_t>("32768", -32768);
+  check<int16_t>("-32769", -32768);
+  check<int16_t>("32768", 32767);
   check<int16_t>(NULL, 0);
   check<int16_t>("true", 1);
   check<int16_t>("false", 0);
@@ -47,8 +47,8 @@ TEST_CASE("parseInteger<int32_t>()") {
   check<int32_t>("+2147483647", 2147483647);
   check<int32_t>("3.14", 3);
   check<int32_t>("x42", 0);
-  check<int32_t>("-2147483649", 2147483647);
-  check<int32_t>("2147483648", (-2147483647 - 1));
+  check<int32_t>("-2147483649", (-2147483647 - 1));
+  check<int32_t>("2147483648", 2147483647);
   check<int32_t>("true", 1);
   check<int32_t>("false", 0);
 }
@@ -59,8 +59,8 @@ TEST_CASE("parseInteger<uint8_t>()") {
   check<uint8_t>("+255", 255);
   check<uint8_t>("3.14", 3);
   check<uint8_t>("x42", 0);
-  check<uint8_t>("-1", 255);
-  check<uint8_t>("256", 0);
+  check<uint8_t>("-1", 0);
+  check<uint8_t>("256", 255);
   check<uint8_t>("true", 1);
   check<uint8_t>("false", 0);
 }
@@ -72,8 +72,50 @@ TEST_CASE("parseInteger<uint16_t>()") {
   check<uint16_t>("3.14", 3);
   // check<uint16_t>(" 42", 0);
   check<uint16_t>("x42", 0);
-  check<uint16_t>("-1", 65535);
-  check<uint16_t>("65536", 0);
+  check<uint16_t>("-1", 0);
+  check<uint16_t>("65536", 65535);
   check<uint16_t>("true", 1);
   check<uint16_t>("false", 0);
 }
+
+TEST_CASE("parseInteger<uint32_t>()") {
+  check<uint32_t>("4294967295", 4294967295U);
+  check<uint32_t>("0004294967295", 4294967295U);
+  check<uint32_t>("12345678", 12345678U);
+  check<uint32_t>("123456789", 123456789U);
+  check<uint32_t>("4294967296", 4294967295U);
+  check<uint32_t>("99999999999999999999999", 4294967295U);
+}
+
+TEST_CASE("parseInteger<int64_t>()") {
+  check<int64_t>("9223372036854775807", 9223372036854775807);
+  check<int64_t>("-9223372036854775808", -9223372036854775807 - 1);
+  check<int64_t>("1234567890123456789", 1234567890123456789);
+  check<int64_t>("-1234567890123456", -1234567890123456);
+  check<int64_t>("9223372036854775808", 9223372036854775807);
+  check<int64_t>("-9223372036854775809", -9223372036854775807 - 1);
+  check<int64_t>("18446744073709551616", 9223372036854775807);
+}
+
+TEST_CASE("parseInteger<uint64_t>()") {
+  const uint64_t max = uint64_t(~uint64_t(0));
+  check<uint64_t>("18446744073709551615", max);
+  check<uint64_t>("18446744073709551616", max);
+  check<uint64_t>("99999999999999999999", max);
+  check<uint64_t>("100000000000000000000", max);
+  check<uint64_t>("-1", 0);
+}
+
+TEST_CASE("parseInteger() reports overflows") {
+  int8_t i8;
+  uint32_t u32;
+
+  REQUIRE(parseInteger("127", i8));
+  REQUIRE(parseInteger("-128", i8));
+  REQUIRE_FALSE(parseInteger("128", i8));
+  REQUIRE_FALSE(parseInteger("-129", i8));
+  REQUIRE(parseInteger("0", u32));
+  REQUIRE_FALSE(parseInteger("-1", u32));
+  REQUIRE_FALSE(parseInteger("4294967296", u32));
+  REQUIRE_FALSE(parseInteger("18446744073709551616", u32));
+}
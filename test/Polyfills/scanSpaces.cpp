@@ -0,0 +1,45 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#include <ArduinoJson/Polyfills/scanSpaces.hpp>
+#include <catch.hpp>
+#include <string>
+
+using namespace ArduinoJson::Internals;
+
+static size_t scan(const std::string& s) {
+  return scanSpaces(s.data(), s.size());
+}
+
+TEST_CASE("scanSpaces()") {
+  SECTION("Counts the spaces, tabs and line breaks") {
+    REQUIRE(0 == scan("{}"));
+    REQUIRE(1 == scan(" {}"));
+    REQUIRE(4 == scan(" \t\r\n{}"));
+  }
+
+  SECTION("Stops at the end of the input") {
+    REQUIRE(0 == scan(""));
+    REQUIRE(3 == scan("   "));
+    REQUIRE(40 == scan(std::string(40, ' ')));
+  }
+
+  SECTION("Stops at the terminator") {
+    REQUIRE(2 == scan(std::string("  \0  ", 5)));
+  }
+
+  SECTION("Doesn't skip the other control characters") {
+    REQUIRE(1 == scan(" \v"));
+    REQUIRE(1 == scan(" \f"));
+  }
+
+  SECTION("Finds the character at every position") {
+    for (size_t i = 0; i < 80; i++) {
+      std::string s(80, '\n');
+      s[i] = '"';
+      CAPTURE(i);
+      REQUIRE(i == scan(s));
+    }
+  }
+}
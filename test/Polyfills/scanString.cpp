@@ -0,0 +1,55 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#include <ArduinoJson/Polyfills/scanString.hpp>
+#include <catch.hpp>
+#include <string>
+
+using namespace ArduinoJson::Internals;
+
+static size_t scan(const std::string& s, char quote = '"') {
+  return scanString(s.data(), s.size(), quote);
+}
+
+TEST_CASE("scanString()") {
+  SECTION("Stops at the quote") {
+    REQUIRE(5 == scan("hello\" world"));
+    REQUIRE(0 == scan("\"hello"));
+    REQUIRE(16 == scan("0123456789abcdef\""));
+    REQUIRE(17 == scan("0123456789abcdefg\"h"));
+  }
+
+  SECTION("Stops at the backslash") {
+    REQUIRE(5 == scan("hello\\n"));
+    REQUIRE(11 == scan("hello world\\n"));
+  }
+
+  SECTION("Stops at the terminator") {
+    REQUIRE(9 == scan(std::string("0123456789", 10).replace(9, 1, 1, '\0')));
+  }
+
+  SECTION("Ignores the other quote") {
+    REQUIRE(13 == scan("it's a 'test'\"", '"'));
+    REQUIRE(8 == scan("say \"hi\"'", '\''));
+  }
+
+  SECTION("Stops at the end of the input") {
+    REQUIRE(0 == scan(""));
+    REQUIRE(3 == scan("abc"));
+    REQUIRE(20 == scan("01234567890123456789"));
+  }
+
+  SECTION("Finds the character at every position") {
+    for (size_t i = 0; i < 40; i++) {
+      std::string s(40, 'x');
+      s[i] = '\\';
+      CAPTURE(i);
+      REQUIRE(i == scan(s));
+    }
+  }
+
+  SECTION("Accepts the characters with the high bit set") {
+    REQUIRE(12 == scan("caf\xC3\xA9 cr\xC3\xA8me\""));
+  }
+}
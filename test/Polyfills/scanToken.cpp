@@ -0,0 +1,59 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#include <ArduinoJson/Polyfills/scanToken.hpp>
+#include <catch.hpp>
+#include <string>
+
+using namespace ArduinoJson::Internals;
+
+static size_t scan(const std::string& s) {
+  return scanToken(s.data(), s.size());
+}
+
+TEST_CASE("scanToken()") {
+  SECTION("Stops at the structural characters") {
+    REQUIRE(5 == scan("12345,"));
+    REQUIRE(4 == scan("true]"));
+    REQUIRE(4 == scan("null}"));
+    REQUIRE(3 == scan("key:1"));
+    REQUIRE(0 == scan("[1]"));
+    REQUIRE(0 == scan("{}"));
+    REQUIRE(16 == scan("-1234567.89e+012,"));
+    REQUIRE(17 == scan("0123456789abcdefg]h"));
+  }
+
+  SECTION("Stops at the spaces, the quotes and the terminator") {
+    REQUIRE(5 == scan("false \t"));
+    REQUIRE(3 == scan("abc\"def"));
+    REQUIRE(3 == scan("abc'def"));
+    REQUIRE(9 == scan(std::string("0123456789", 10).replace(9, 1, 1, '\0')));
+  }
+
+  SECTION("Stops at the end of the input") {
+    REQUIRE(0 == scan(""));
+    REQUIRE(3 == scan("abc"));
+    REQUIRE(40 == scan(std::string(40, 'x')));
+  }
+
+  SECTION("Finds the character at every position") {
+    for (size_t i = 0; i < 40; i++) {
+      std::string s(40, '7');
+      s[i] = ',';
+      CAPTURE(i);
+      REQUIRE(i == scan(s));
+    }
+  }
+
+  SECTION("Agrees with isTokenChar() on every character") {
+    for (int c = 1; c < 256; c++) {
+      std::string s(40, 'a');
+      s[33] = static_cast<char>(c);
+      s[17] = static_cast<char>(c);
+      s[3] = static_cast<char>(c);
+      CAPTURE(c);
+      REQUIRE((isTokenChar(static_cast<char>(c)) ? 40u : 3u) == scan(s));
+    }
+  }
+}
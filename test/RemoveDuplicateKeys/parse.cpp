@@ -0,0 +1,80 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#define ARDUINOJSON_REMOVE_DUPLICATE_KEYS 0
+#include <ArduinoJson.h>
+#include <catch.hpp>
+#include <sstream>
+#include <string>
+
+TEST_CASE("ARDUINOJSON_REMOVE_DUPLICATE_KEYS == 0") {
+  DynamicJsonBuffer jb;
+
+  SECTION("The first value wins") {
+    JsonObject& obj = jb.parseObject("{\"a\":1,\"b\":2,\"a\":3}");
+    REQUIRE(obj.success());
+    REQUIRE(obj.size() == 3);
+    REQUIRE(obj["a"] == 1);
+    REQUIRE(obj["b"] == 2);
+  }
+
+  SECTION("The duplicates are serialized") {
+    std::string json;
+    jb.parseObject("{\"a\":1,\"b\":2,\"a\":3}").printTo(json);
+    REQUIRE(json == "{\"a\":1,\"b\":2,\"a\":3}");
+  }
+
+  SECTION("removeDuplicateKeys() merges them afterwards") {
+    JsonObject& obj = jb.parseObject("{\"a\":1,\"b\":2,\"a\":3}");
+    obj.removeDuplicateKeys();
+    std::string json;
+    obj.printTo(json);
+    REQUIRE(json == "{\"a\":3,\"b\":2}");
+  }
+
+  SECTION("Big objects take no room for a hash table") {
+    std::ostringstream input;
+    input << '{';
+    for (int i = 0; i < 64; i++) input << "\"k" << i % 32 << "\":" << i << ',';
+    input << "\"k0\":-1}";
+    std::string json = input.str();
+
+    JsonObject& obj = jb.parseObject(&json[0]);
+    REQUIRE(jb.size() == JSON_OBJECT_SIZE(65));
+
+    REQUIRE(obj.size() == 65);
+    REQUIRE(obj["k0"] == 0);
+    REQUIRE(obj["k31"] == 31);
+  }
+
+#if ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+  SECTION("The first non-const read builds the hash table") {
+    std::ostringstream input;
+    input << '{';
+    for (int i = 0; i < 1000; i++)
+      input << (i ? "," : "") << "\"k" << i << "\":" << i;
+    input << '}';
+
+    JsonObject& obj = jb.parseObject(input.str());
+    REQUIRE(obj.size() == 1000);
+    size_t size = jb.size();
+
+    const JsonObject& cobj = obj;
+    REQUIRE(cobj["k999"].as<int>() == 999);
+    REQUIRE(jb.size() == size);
+
+    REQUIRE(obj["k999"].as<int>() == 999);
+    REQUIRE(jb.size() >= size + 1000 * sizeof(void*));
+    size = jb.size();
+    for (int i = 0; i < 1000; i++) {
+      std::ostringstream key;
+      key << 'k' << i;
+      REQUIRE(obj.get<int>(key.str()) == i);
+      REQUIRE(obj.containsKey(key.str()));
+      REQUIRE(obj.is<int>(key.str()));
+    }
+    REQUIRE(jb.size() == size);
+  }
+#endif
+}
@@ -0,0 +1,44 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2018
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+using namespace ArduinoJson::Internals;
+
+TEST_CASE("StaticJsonBuffer::release()") {
+  StaticJsonBuffer<256> buffer;
+
+  SECTION("Goes back to the size of the mark") {
+    buffer.alloc(3);
+    StaticJsonBufferBase::Mark mark = buffer.mark();
+    size_t size = buffer.size();
+    buffer.alloc(40);
+    buffer.release(mark);
+    REQUIRE(buffer.size() == size);
+  }
+
+  SECTION("Reuses the released memory") {
+    StaticJsonBufferBase::Mark mark = buffer.mark();
+    void* p1 = buffer.alloc(40);
+    buffer.release(mark);
+    void* p2 = buffer.alloc(40);
+    REQUIRE(p1 == p2);
+  }
+
+  SECTION("Discards a speculative subtree") {
+    JsonObject& root = buffer.createObject();
+    root["status"] = "ok";
+    size_t size = buffer.size();
+
+    StaticJsonBufferBase::Mark mark = buffer.mark();
+    JsonArray& items = buffer.createArray();
+    items.add(1);
+    items.add(2);
+    buffer.release(mark);
+
+    REQUIRE(buffer.size() == size);
+    REQUIRE(root["status"] == std::string("ok"));
+  }
+}
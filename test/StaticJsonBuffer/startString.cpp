@@ -46,4 +46,26 @@ TEST_CASE("StaticJsonBuffer::startString()") {
     str.c_str();
     REQUIRE(2 == jsonBuffer.size());
   }
+
+  SECTION("AppendsSeveralCharacters") {
+    StaticJsonBuffer<6> jsonBuffer;
+
+    StaticJsonBufferBase::String str = jsonBuffer.startString();
+    str.append("hel", 3);
+    str.append("lo", 2);
+
+    REQUIRE(std::string("hello") == str.c_str());
+    REQUIRE(6 == jsonBuffer.size());
+  }
+
+  SECTION("KeepsWhatFitsWhenAppendingSeveralCharacters") {
+    StaticJsonBuffer<5> jsonBuffer;
+
+    StaticJsonBufferBase::String str = jsonBuffer.startString();
+    str.append("hel", 3);
+    str.append("lo!", 3);
+
+    REQUIRE(5 == jsonBuffer.size());
+    REQUIRE(0 == str.c_str());
+  }
 }